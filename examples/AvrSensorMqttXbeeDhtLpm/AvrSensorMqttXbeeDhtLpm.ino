@@ -16,19 +16,27 @@
 /* External Includes */
 #include <MemoryFree.h>
 #include <MqttClient.h>
-#include <SoftwareSerial.h>
 #include <ArduinoJson.h>
 #include <DHT.h>
 /* Internal Includes */
 #include <ButlerArduinoLibrary.h>
+#include <ButlerArduinoStrings.hpp>
 #include <ButlerArduinoLogger.hpp>
 #include <ButlerArduinoNetwork.hpp>
-#include <ButlerArduinoUartNetwork.hpp>
+#include <ButlerArduinoXbeeNetwork.hpp>
+#include <ButlerArduinoBufferChain.hpp>
+#include <ButlerArduinoMqtt.hpp>
+#include <ButlerArduinoPayloadSize.hpp>
 #include <ButlerArduinoDhtSensor.hpp>
 #include <ButlerArduinoAvrLpm.hpp>
-#include <ButlerArduinoSwUart.hpp>
+#include <ButlerArduinoAvrSwUart.hpp>
 #include <ButlerArduinoHwUart.hpp>
+#include <ButlerArduinoAsyncPrint.hpp>
 #include <ButlerArduinoSensorLoop.hpp>
+#include <ButlerArduinoMqttStack.hpp>
+#include <ButlerArduinoStaticObject.hpp>
+#include <ButlerArduinoHeapGuard.h>
+#include <ButlerArduinoMemProfiler.h>
 
 
 ////////// CONFIGURATION //////////
@@ -44,24 +52,46 @@
 #define MQTT_HOST									"STUB"
 #define MQTT_PORT									0
 #define MQTT_MAX_PACKET_SIZE						128
-#define MQTT_MAX_PAYLOAD_SIZE						96
+#define MQTT_MAX_SEND_PACKET_SIZE					64 // PUBLISH goes to the network as a chain
 #define MQTT_MAX_MESSAGE_HANDLERS					1
 #define MQTT_COMMAND_TIMEOUT_MS						(3*1000L)
 #define MQTT_KEEP_ALIVE_INTERVAL_SEC				(lCtx.publishPeriodMs/1000L*2)
 #define MQTT_SUBSCRIBE_QOS							MqttClient::QOS0
-#define MQTT_SUBSCRIBE_TOPIC_CFG					DOMAIN "/sensor/" ID "/config"
+#define MQTT_SUBSCRIBE_TOPIC_CFG					BUTLER_ARDUINO_TOPIC_MODEL_CONFIG(DOMAIN, "sensor", ID)
 #define MQTT_PUBLISH_QOS							MqttClient::QOS0
-#define MQTT_PUBLISH_TOPIC							DOMAIN "/sensor/" ID "/data"
+#define MQTT_PUBLISH_TOPIC							BUTLER_ARDUINO_TOPIC_MODEL_DATA(DOMAIN, "sensor", ID)
 #define MQTT_LISTEN_TIME_MS							(3*1000L)
 #define MQTT_PUBLISH_PERIOD_MS						(1*60*1000L)
 #define MQTT_UPDATE_CONFIG_PERIOD_MS				(lCtx.publishPeriodMs*3L)
 #define MQTT_CONNECT_RETRIES_QTY					5
+
+////////// PAYLOAD //////////
+// DHT values: up to 3 integral digits and 1 decimal
+typedef Butler::Arduino::Payload::SensorPayload<
+	sizeof(ID) - 1, 2, 5, Butler::Arduino::Payload::floatWidth(3, 1)
+> Payload;
+static_assert(
+	Butler::Arduino::Mqtt::publishPacketSize(sizeof(MQTT_PUBLISH_TOPIC) - 1, Payload::SIZE) <= MQTT_MAX_PACKET_SIZE,
+	"Payload doesn't fit the MQTT packet"
+);
 #define MQTT_DISCONNECTED_IDLE_PERIOD_MS			(2*60*1000L)
 #define NETWORK_HIBERNATE_DELAY_MS					10
 #define NETWORK_WAKE_UP_DELAY_MS					10
 #define LPM_MODE									Butler::Arduino::LPM_MODE_PWR_DOWN
 #define HW_UART_SPEED								57600L
-#define SW_UART_SPEED								9600L
+#define SW_UART_SPEED								38400L
+#define SW_UART_RX_BUFFER_SIZE						128
+#define XBEE_PAYLOAD_MAX_SIZE						84
+#define XBEE_FRAME_BUFFER_SIZE						192
+// The received frame waits in the UART while the not read data takes the buffer
+static_assert(
+	2 * Butler::Arduino::xbeeRxFrameSize(XBEE_PAYLOAD_MAX_SIZE) <= XBEE_FRAME_BUFFER_SIZE,
+	"XBee buffer doesn't fit two frames"
+);
+static_assert(
+	Butler::Arduino::xbeeRxFrameUartSize(XBEE_PAYLOAD_MAX_SIZE, false) <= SW_UART_RX_BUFFER_SIZE,
+	"UART RX ring doesn't fit the XBee frame"
+);
 
 ////////// OBJECTS DECLARATION //////////
 class SystemImpl: public MqttClient::System, public Butler::Arduino::Time::Clock {
@@ -71,23 +101,45 @@ public:
 	}
 };
 
+typedef Butler::Arduino::MqttStack<
+	Butler::Arduino::Uart, MqttClient::NetworkImpl<Butler::Arduino::Network>,
+	MQTT_MAX_SEND_PACKET_SIZE, MQTT_MAX_PACKET_SIZE, MQTT_MAX_MESSAGE_HANDLERS
+> MqttStack;
+
 ////////// OBJECTS //////////
 Butler::Arduino::Context							gCtx;
 Butler::Arduino::LoopContext						lCtx;
 Butler::Arduino::LoopConstants						lConst;
-Butler::Arduino::Network							*network = NULL;
-Butler::Arduino::DhtSensor							sensor(*new DHT(PIN_DHT, DHTTYPE));
+SystemImpl											sys;
+Butler::Arduino::StaticObject<Butler::Arduino::HwUart>		hwUart;
+Butler::Arduino::StaticObject<Butler::Arduino::AvrSwUart<SW_UART_RX_BUFFER_SIZE>>	swUart;
+Butler::Arduino::StaticObject<Butler::Arduino::AsyncPrint<>>	logPrint;
+Butler::Arduino::StaticObject<Butler::Arduino::AvrLpm>		lpm;
+Butler::Arduino::StaticObject<Butler::Arduino::XbeeNetwork<XBEE_FRAME_BUFFER_SIZE>>	network;
+Butler::Arduino::StaticObject<MqttStack>			mqtt;
+DHT													dht(PIN_DHT, DHTTYPE);
+Butler::Arduino::DhtSensor							sensor(dht);
 
 ////////// IMPLEMENTATION //////////
 void initLoopConstants(Butler::Arduino::LoopConstants& lConst);
 
 void check() {
-	LOG_PRINTFLN(gCtx, "#################################");
-	LOG_PRINTFLN(gCtx, "###      Periodic check       ###");
-	LOG_PRINTFLN(gCtx, "### Memory Free :    %.5u B  ###", freeMemory());
-	LOG_PRINTFLN(gCtx, "### Time        : %.8lu Ms ###", gCtx.time->millis());
-	LOG_PRINTFLN(gCtx, "### Period      : %.8lu Ms ###", lCtx.publishPeriodMs);
-	LOG_PRINTFLN(gCtx, "#################################");
+	LOG_INFO(gCtx, APP, "#################################");
+	LOG_INFO(gCtx, APP, "###      Periodic check       ###");
+	LOG_INFO(gCtx, APP, "### Memory Free :    %.5u B  ###", freeMemory());
+	LOG_INFO(gCtx, APP, "### Time        : %.8lu Ms ###", gCtx.time->millis());
+	LOG_INFO(gCtx, APP, "### Period      : %.8lu Ms ###", lCtx.publishPeriodMs);
+	{
+		const Butler::Arduino::AvrSwUartStats stats = swUart.get().getStats();
+		LOG_INFO(gCtx, APP, "### UART Errors : %.4u/%.4u  ###", stats.framingErrors, stats.overruns);
+	}
+	LOG_INFO(gCtx, APP, "### XBee Fails  : %.8u    ###", network->getStats().deliveryFailures);
+#if BUTLER_NO_HEAP_AFTER_SETUP
+	LOG_INFO(gCtx, APP, "### Heap Allocs : %.8lu    ###", Butler::Arduino::HeapGuard::getViolationsQty());
+#endif
+	LOG_INFO(gCtx, APP, "#################################");
+	MEM_PROFILER_LOG(gCtx);
+	MEM_PROFILER_PHASE(CHECK);
 }
 
 void buildMessagePayload(char* buffer, int size) {
@@ -96,16 +148,8 @@ void buildMessagePayload(char* buffer, int size) {
 	Butler::Arduino::SensorValue vTemp = sensor.getTemperature();
 	Butler::Arduino::SensorValue vHumid = sensor.getHumidity();
 	digitalWrite(PIN_DHT_ON, LOW);
-	// Predict buffer size
-	const int NUMBER_OF_ROOT_PARAMETERS = 3;
-	const int NUMBER_OF_SENSORS = 2;
-	const int NUMBER_OF_SENSORS_PARAMETERS = 1;
-	const int BUFFER_SIZE =
-		JSON_OBJECT_SIZE(NUMBER_OF_ROOT_PARAMETERS)								// root
-		+ JSON_ARRAY_SIZE(NUMBER_OF_SENSORS)									// data array
-		+ JSON_OBJECT_SIZE(NUMBER_OF_SENSORS_PARAMETERS)*NUMBER_OF_SENSORS;		// data array elements
 	// Allocate buffer
-	StaticJsonBuffer<BUFFER_SIZE> jsonBuffer;
+	StaticJsonBuffer<Payload::JSON_BUFFER_SIZE> jsonBuffer;
 	// Encode message
 	JsonArray& data = jsonBuffer.createArray();
 	if (sensor.verify(vTemp)) {
@@ -126,21 +170,29 @@ void buildMessagePayload(char* buffer, int size) {
 	root.printTo(buffer, size);
 }
 
+void buildMessagePayloadChain(Butler::Arduino::BufferChainBase& chain, const Butler::Arduino::CharBufferView& scratch) {
+	buildMessagePayload(scratch.get(), scratch.size());
+	// Keep the terminating null like the MqttClient publish does
+	chain.add(Butler::Arduino::ConstBufferView(
+		reinterpret_cast<const uint8_t*>(scratch.get()), strlen(scratch.get()) + 1
+	));
+}
+
 void processMessageConfig(MqttClient::MessageData& md) {
 	bool changed = false;
 	const MqttClient::Message& msg = md.message;
 	char payload[msg.payloadLen + 1];
 	memcpy(payload, msg.payload, msg.payloadLen);
 	payload[msg.payloadLen] = '\0';
-	LOG_PRINTFLN(gCtx, "Configuration arrived: %s", payload);
+	LOG_INFO(gCtx, APP, "Configuration arrived: %s", payload);
 	// Predict buffer size
 	const int NUMBER_OF_ROOT_PARAMETERS = 1;
-	const int BUFFER_SIZE = JSON_OBJECT_SIZE(NUMBER_OF_ROOT_PARAMETERS);
-	DynamicJsonBuffer jsonBuffer(BUFFER_SIZE);
+	// No heap after setup
+	StaticJsonBuffer<JSON_OBJECT_SIZE(NUMBER_OF_ROOT_PARAMETERS)> jsonBuffer;
 	JsonObject& root = jsonBuffer.parseObject(&payload[0]);
 	// Check if parsing succeeds
 	if (!root.success()) {
-		LOG_PRINTFLN(gCtx, "ERROR, Can't pars configuration");
+		LOG_ERROR(gCtx, APP, "ERROR, Can't pars configuration");
 		return;
 	}
 	// Reconnect if publishPeriodMs is changed to update keep-alive timer
@@ -151,7 +203,7 @@ void processMessageConfig(MqttClient::MessageData& md) {
 	}
 	// TODO: Store publishPeriodMs to EEPROM
 	if (changed) {
-		LOG_PRINTFLN(gCtx, "Configuration changed => reconnect");
+		LOG_INFO(gCtx, APP, "Configuration changed => reconnect");
 		initLoopConstants(lConst);
 		lCtx.mqtt->disconnect();
 	}
@@ -168,9 +220,11 @@ void networkDisconnect() {
 void networkHibernate() {
 	gCtx.lpm->idle(NETWORK_HIBERNATE_DELAY_MS);
 	digitalWrite(PIN_LPM_NETWORK, HIGH);
+	lpm->setUartAwake(false);
 }
 
 void networkWakeUp() {
+	lpm->setUartAwake(true);
 	digitalWrite(PIN_LPM_NETWORK, LOW);
 	gCtx.lpm->idle(NETWORK_WAKE_UP_DELAY_MS);
 }
@@ -180,7 +234,7 @@ void initLoopConstants(Butler::Arduino::LoopConstants& lConst) {
 	lConst.connectAttemptsMaxQty = MQTT_CONNECT_RETRIES_QTY;
 	lConst.keepAlivePeriodSec = MQTT_KEEP_ALIVE_INTERVAL_SEC;
 	lConst.disconnectedIdlePeriodMs = MQTT_DISCONNECTED_IDLE_PERIOD_MS;
-	lConst.publishPayloadMaxSize = MQTT_MAX_PAYLOAD_SIZE;
+	lConst.publishPayloadMaxSize = Payload::SIZE;
 	lConst.publishTopic = MQTT_PUBLISH_TOPIC;
 	lConst.publishQoS = MQTT_PUBLISH_QOS;
 	lConst.configUpdatePeriodMs = MQTT_UPDATE_CONFIG_PERIOD_MS;
@@ -195,42 +249,49 @@ void initLoopConstants(Butler::Arduino::LoopConstants& lConst) {
 	lConst.networkHibernate = networkHibernate;
 	lConst.networkWakeUp = networkWakeUp;
 	lConst.buildMessagePayload = buildMessagePayload;
+	lConst.buildMessagePayloadChain = buildMessagePayloadChain;
 	lConst.processConfigMessage = processMessageConfig;
 }
 
 /** Called once at startup */
 void setup() {
+	MEM_PROFILER_BEGIN();
+	MEM_PROFILER_PHASE(SETUP);
 	//// RESET ////
 	gCtx = Butler::Arduino::Context();
 	lCtx = Butler::Arduino::LoopContext();
 	lConst = Butler::Arduino::LoopConstants();
 
-	//// SYSTEM ////
-	SystemImpl *system = new SystemImpl;
-
 	//// TIME ////
-	gCtx.time = system;
+	gCtx.time = &sys;
 
 	//// HW UART ////
-	Butler::Arduino::Uart *hwUart = new Butler::Arduino::HwUart({HW_UART_SPEED});
+	hwUart.create(Butler::Arduino::HwUartConfig{HW_UART_SPEED});
 
 	//// SF UART ////
-	Butler::Arduino::Uart *swUart = new Butler::Arduino::SwUart({SW_UART_SPEED, PIN_SW_UART_RX, PIN_SW_UART_TX});
+	swUart.create(Butler::Arduino::AvrSwUartConfig{SW_UART_SPEED, PIN_SW_UART_RX, PIN_SW_UART_TX});
 
 	//// LOG ////
-	gCtx.logger = hwUart;
+	gCtx.logger = &logPrint.create(hwUart.get());
 
 	//// LPM ////
 	{
 		Butler::Arduino::AvrLpmConfig config;
 		config.pinLedAwake = PIN_LED_AWAKE;
 		config.mode = LPM_MODE;
-		gCtx.lpm = new Butler::Arduino::AvrLpm(config);
+		config.ctx = &gCtx;
+		config.uart = &swUart.get();
+		gCtx.lpm = &lpm.create(config);
 	}
 
 	//// NETWORK ////
 	pinMode(PIN_LPM_NETWORK, OUTPUT);
-	network = new Butler::Arduino::UartNetwork(*swUart);
+	{
+		// Coordinator is the destination
+		Butler::Arduino::XbeeNetworkConfig config;
+		config.payloadMaxSize = XBEE_PAYLOAD_MAX_SIZE;
+		lCtx.network = &network.create(swUart.get(), config);
+	}
 
 	//// SENSORS ////
 	pinMode(PIN_DHT_ON, OUTPUT);
@@ -243,17 +304,9 @@ void setup() {
 
 	//// MQTT ////
 	{
-		MqttClient::Logger *mqttLogger = new MqttClient::LoggerImpl<Butler::Arduino::Uart>(*hwUart);
-		MqttClient::Network *mqttNetwork = new MqttClient::NetworkImpl<Butler::Arduino::Network>(*network, *system);
-		MqttClient::Buffer *mqttSendBuffer = new MqttClient::ArrayBuffer<MQTT_MAX_PACKET_SIZE>();
-		MqttClient::Buffer *mqttRecvBuffer = new MqttClient::ArrayBuffer<MQTT_MAX_PACKET_SIZE>();
-		MqttClient::MessageHandlers *mqttMessageHandlers = new MqttClient::MessageHandlersImpl<MQTT_MAX_MESSAGE_HANDLERS>();
 		MqttClient::Options options;
 		options.commandTimeoutMs = MQTT_COMMAND_TIMEOUT_MS;
-		lCtx.mqtt = new MqttClient(
-			options, *mqttLogger, *system, *mqttNetwork, *mqttSendBuffer,
-			*mqttRecvBuffer, *mqttMessageHandlers
-		);
+		lCtx.mqtt = &mqtt.create(options, sys, hwUart.get(), network.get()).getClient();
 	}
 
 	//// LOOP SETUP ////
@@ -261,10 +314,13 @@ void setup() {
 	Butler::Arduino::Loop::setup(gCtx, lCtx, lConst);
 
 	////// INIT END //////
-	LOG_PRINTFLN(gCtx, "#################################");
-	LOG_PRINTFLN(gCtx, "###      Butler Sensor        ###");
-	LOG_PRINTFLN(gCtx, "### ID          : %11s ###", ID);
-	LOG_PRINTFLN(gCtx, "#################################");
+	LOG_INFO(gCtx, APP, "#################################");
+	LOG_INFO(gCtx, APP, "###      Butler Sensor        ###");
+	LOG_INFO(gCtx, APP, "### ID          : %11s ###", ID);
+	LOG_INFO(gCtx, APP, "#################################");
+
+	//// NO HEAP FROM NOW ////
+	Butler::Arduino::HeapGuard::lock();
 }
 
 /** Endless main loop */
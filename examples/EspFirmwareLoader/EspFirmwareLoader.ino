@@ -38,9 +38,9 @@ Butler::Arduino::EspManager<Configuration>			manager;
 ////////// IMPLEMENTATION //////////
 void setup() {
 	manager.setup();
-	LOG_PRINTFLN(manager.getContext(), "#################################");
-	LOG_PRINTFLN(manager.getContext(), "###    Butler Firmware Loader");
-	LOG_PRINTFLN(manager.getContext(), "#################################");
+	LOG_INFO(manager.getContext(), APP, "#################################");
+	LOG_INFO(manager.getContext(), APP, "###    Butler Firmware Loader");
+	LOG_INFO(manager.getContext(), APP, "#################################");
 	////// INIT END //////
 	manager.printState();
 	manager.waitNetwork();
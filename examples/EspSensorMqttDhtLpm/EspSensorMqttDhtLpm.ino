@@ -24,6 +24,10 @@
 #include <ButlerArduinoWiFiJsonConfig.hpp>
 #include <ButlerArduinoAuthJsonConfig.hpp>
 #include <ButlerArduinoEspManager.hpp>
+#include <ButlerArduinoMqtt.hpp>
+#include <ButlerArduinoPayloadSize.hpp>
+#include <ButlerArduinoMqttStack.hpp>
+#include <ButlerArduinoStaticObject.hpp>
 
 
 ////////// CONFIGURATION //////////
@@ -31,7 +35,7 @@ ADC_MODE(ADC_VCC);
 #define DHTTYPE										DHT11
 #define PIN_DHT										2
 #define MQTT_MAX_PACKET_SIZE							128
-#define MQTT_MAX_PAYLOAD_SIZE						96
+#define MQTT_PUBLISH_TOPIC_LENGTH_MAX				48 // <ns>/<g>/<id>/data
 #define MQTT_MAX_MESSAGE_HANDLERS					1
 #define MQTT_COMMAND_TIMEOUT_MS						(3*1000L)
 #define MQTT_KEEP_ALIVE_INTERVAL_SEC					(lCtx.publishPeriodMs/1000L*2)
@@ -39,6 +43,16 @@ ADC_MODE(ADC_VCC);
 #define MQTT_PUBLISH_QOS								MqttClient::QOS0
 #define MQTT_LISTEN_TIME_MS							(1*1000L)
 
+////////// PAYLOAD //////////
+// ID is the MAC address hex, DHT values: up to 3 integral digits and 1 decimal
+typedef Butler::Arduino::Payload::SensorPayload<
+	12, 2, 5, Butler::Arduino::Payload::floatWidth(3, 1)
+> Payload;
+static_assert(
+	Butler::Arduino::Mqtt::publishPacketSize(MQTT_PUBLISH_TOPIC_LENGTH_MAX, Payload::SIZE) <= MQTT_MAX_PACKET_SIZE,
+	"Payload doesn't fit the MQTT packet"
+);
+
 
 ////////// DECLARATION //////////
 
@@ -50,8 +64,8 @@ struct AppJsonConfig: public Butler::Arduino::Config::JsonConfigNode {
 	bool decode(JsonObject &json) {
 		bool updated = false;
 		// PERIOD
-		if (json.containsKey(Butler::Arduino::Strings::PERIOD)) {
-			uint32_t v = json[Butler::Arduino::Strings::PERIOD];
+		if (json.containsKey(Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD))) {
+			uint32_t v = json[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD)];
 			if (v != period) {
 				period = v;
 				updated = true;
@@ -62,7 +76,7 @@ struct AppJsonConfig: public Butler::Arduino::Config::JsonConfigNode {
 
 	void encode(JsonObject &json, JsonBuffer &jsonBuffer) {
 		// PERIOD
-		json[Butler::Arduino::Strings::PERIOD] = period;
+		json[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD)] = period;
 	}
 };
 
@@ -108,40 +122,52 @@ IdleMemory											idleMemory;
 Butler::Arduino::EspManager<Configuration>			manager;
 Butler::Arduino::LoopContext							lCtx;
 Butler::Arduino::LoopConstants						lConst;
-Butler::Arduino::DhtSensor							sensor(*new DHT(PIN_DHT, DHTTYPE));
+DHT													dht(PIN_DHT, DHTTYPE);
+Butler::Arduino::DhtSensor							sensor(dht);
 WiFiClientSecure										network;
 
+class SystemImpl: public MqttClient::System {
+public:
+	unsigned long millis() const {
+		return manager.getClock().millis();
+	}
+
+	void yield(void) {
+		::yield();
+	}
+};
+
+typedef Butler::Arduino::MqttStack<
+	HardwareSerial, MqttClient::NetworkClientImpl<WiFiClient>,
+	MQTT_MAX_PACKET_SIZE, MQTT_MAX_PACKET_SIZE, MQTT_MAX_MESSAGE_HANDLERS
+> MqttStack;
+
+SystemImpl											mqttSystem;
+Butler::Arduino::StaticObject<MqttStack>			mqtt;
+
 ////////// IMPLEMENTATION //////////
 void buildMessagePayload(char* buffer, int size) {
 	// Get sensor values
 	Butler::Arduino::SensorValue vTemp = sensor.getTemperature();
 	Butler::Arduino::SensorValue vHumid = sensor.getHumidity();
-	// Predict buffer size
-	const int NUMBER_OF_ROOT_PARAMETERS = 3;
-	const int NUMBER_OF_SENSORS = 2;
-	const int NUMBER_OF_SENSORS_PARAMETERS = 1;
-	const int BUFFER_SIZE =
-		JSON_OBJECT_SIZE(NUMBER_OF_ROOT_PARAMETERS)								// root
-		+ JSON_ARRAY_SIZE(NUMBER_OF_SENSORS)									// data array
-		+ JSON_OBJECT_SIZE(NUMBER_OF_SENSORS_PARAMETERS)*NUMBER_OF_SENSORS;		// data array elements
 	// Allocate buffer
-	DynamicJsonBuffer jsonBuffer(BUFFER_SIZE);
+	DynamicJsonBuffer jsonBuffer(Payload::JSON_BUFFER_SIZE);
 	// Encode message
 	JsonArray &data = jsonBuffer.createArray();
 	if (sensor.verify(vTemp)) {
 		JsonObject &obj = jsonBuffer.createObject();
-		obj[Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_TEMPERATURE] = vTemp;
+		obj[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_TEMPERATURE)] = vTemp;
 		data.add(obj);
 	}
 	if (sensor.verify(vHumid)) {
 		JsonObject &obj = jsonBuffer.createObject();
-		obj[Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_HUMIDITY] = vHumid;
+		obj[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_HUMIDITY)] = vHumid;
 		data.add(obj);
 	}
 	JsonObject &root = jsonBuffer.createObject();
-	root[Butler::Arduino::Strings::PAYLOAD_KEY_VERSION] = 1;
-	root[Butler::Arduino::Strings::PAYLOAD_KEY_ID] = lConst.id;
-	root[Butler::Arduino::Strings::PAYLOAD_KEY_DATA] = data;
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_VERSION)] = 1;
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_ID)] = lConst.id;
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_DATA)] = data;
 	// Write to buffer
 	root.printTo(buffer, size);
 }
@@ -154,12 +180,12 @@ void processMessageConfig(MqttClient::MessageData& md) {
 		char payload[msg.payloadLen + 1];
 		memcpy(payload, msg.payload, msg.payloadLen);
 		payload[msg.payloadLen] = '\0';
-		LOG_PRINTFLN(manager.getContext(), "Configuration arrived: %s", payload);
+		LOG_INFO(manager.getContext(), APP, "Configuration arrived: %s", payload);
 		changed = manager.getConfig().update(manager.getContext(), payload);
 	}
 	// Apply
 	if (changed) {
-		LOG_PRINTFLN(manager.getContext(), "Configuration changed");
+		LOG_INFO(manager.getContext(), APP, "Configuration changed");
 		manager.getConfig().store(manager.getContext(), manager.getConfigStorage());
 		manager.restart();
 	}
@@ -174,43 +200,24 @@ void setup() {
 			Butler::Arduino::Strings::TOPIC_MODEL_CONFIG,
 			manager.getConfig().APP_NAMESPACE,
 			manager.getConfig().APP_GROUP,
-			manager.getId()
+			manager.getId().c_str()
 	);
 	manager.getConfig().mqttTopicData = Butler::Arduino::Util::makeTopic(
 			Butler::Arduino::Strings::TOPIC_MODEL_DATA,
 			manager.getConfig().APP_NAMESPACE,
 			manager.getConfig().APP_GROUP,
-			manager.getId()
+			manager.getId().c_str()
 	);
 	//// MQTT ////
 	{
-		class SystemImpl: public MqttClient::System {
-		public:
-			unsigned long millis() const {
-				return manager.getClock().millis();
-			}
-
-			void yield(void) {
-				::yield();
-			}
-		};
-		MqttClient::System *mqttSystem = new SystemImpl;
-		MqttClient::Logger *mqttLogger = new MqttClient::LoggerImpl<HardwareSerial>(Serial);
-		MqttClient::Network *mqttNetwork = new MqttClient::NetworkClientImpl<WiFiClient>(network, *mqttSystem);
-		MqttClient::Buffer *mqttSendBuffer = new MqttClient::ArrayBuffer<MQTT_MAX_PACKET_SIZE>();
-		MqttClient::Buffer *mqttRecvBuffer = new MqttClient::ArrayBuffer<MQTT_MAX_PACKET_SIZE>();
-		MqttClient::MessageHandlers *mqttMessageHandlers = new MqttClient::MessageHandlersImpl<MQTT_MAX_MESSAGE_HANDLERS>();
 		MqttClient::Options options;
 		options.commandTimeoutMs = MQTT_COMMAND_TIMEOUT_MS;
-		lCtx.mqtt = new MqttClient(
-			options, *mqttLogger, *mqttSystem, *mqttNetwork, *mqttSendBuffer,
-			*mqttRecvBuffer, *mqttMessageHandlers
-		);
+		lCtx.mqtt = &mqtt.create(options, mqttSystem, Serial, network).getClient();
 	}
 	//// LOOP SETUP ////
 	lConst.id = manager.getId().c_str();
 	lConst.keepAlivePeriodSec = MQTT_KEEP_ALIVE_INTERVAL_SEC;
-	lConst.publishPayloadMaxSize = MQTT_MAX_PAYLOAD_SIZE;
+	lConst.publishPayloadMaxSize = Payload::SIZE;
 	lConst.publishTopic = manager.getConfig().mqttTopicData.c_str();
 	lConst.publishQoS = MQTT_PUBLISH_QOS;
 	lConst.configTopic = manager.getConfig().mqttTopicConfig.c_str();
@@ -220,16 +227,16 @@ void setup() {
 	lConst.processConfigMessage = processMessageConfig;
 	Butler::Arduino::Loop::setup(manager.getContext(), lCtx, lConst);
 	////// INIT END //////
-	LOG_PRINTFLN(manager.getContext(), "#################################");
-	LOG_PRINTFLN(manager.getContext(), "###    Butler Sensor");
-	LOG_PRINTFLN(manager.getContext(), "#################################");
+	LOG_INFO(manager.getContext(), APP, "#################################");
+	LOG_INFO(manager.getContext(), APP, "###    Butler Sensor");
+	LOG_INFO(manager.getContext(), APP, "#################################");
 }
 
 void loop() {
 	manager.printState();
-	LOG_PRINTFLN(manager.getContext(), "### VCC         : %u", (unsigned int)((ESP.getVcc()/1024.00f)*1000));
-	LOG_PRINTFLN(manager.getContext(), "### Period      : %lu Ms", lCtx.publishPeriodMs);
-	LOG_PRINTFLN(manager.getContext(), "#################################");
+	LOG_INFO(manager.getContext(), APP, "### VCC         : %u", (unsigned int)((ESP.getVcc()/1024.00f)*1000));
+	LOG_INFO(manager.getContext(), APP, "### Period      : %lu Ms", lCtx.publishPeriodMs);
+	LOG_INFO(manager.getContext(), APP, "#################################");
 	manager.waitNetwork();
 	manager.waitNtpTime();
 	// Loop
@@ -0,0 +1,211 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: AVR benchmarks of the library hot paths.
+ *    Must be executed by the simulator runner (see `runner` folder) that
+ *    watches the benchmark markers and reports the exact cycles count
+ *    and the stack high-water mark per benchmark.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <Arduino.h>
+#include <avr/sleep.h>
+/* External Includes */
+#include <ArduinoJson.h>
+/* Internal Includes */
+#include <ButlerArduinoLibrary.h>
+#include <ButlerArduinoCrc.h>
+#include <ButlerArduinoChecksum.hpp>
+#include <ButlerArduinoContext.hpp>
+#include <ButlerArduinoPrint.hpp>
+#include <ButlerArduinoLogger.hpp>
+#include <ButlerArduinoAvrLpm.hpp>
+#include <ButlerArduinoStrings.hpp>
+#include <ButlerArduinoRingBuffer.hpp>
+
+
+////////// MARKERS //////////
+// The registers are watched by the runner. Keep in sync with the runner.
+#define BENCH_MARKER_STATE								GPIOR0
+#define BENCH_MARKER_ID									GPIOR1
+#define BENCH_MARKER_NAME								GPIOR2
+
+#define BENCH_STATE_START								1
+#define BENCH_STATE_STOP								2
+#define BENCH_STATE_DONE								3
+
+////////// CONFIGURATION //////////
+#define PIN_LED_AWAKE									13
+#define CRC_DATA_SIZE									256
+#define PAYLOAD_MAX_SIZE								96
+
+////////// OBJECTS DECLARATION //////////
+namespace Butler {
+namespace Arduino {
+
+struct AvrLpmBench {
+	static void updateSysClock(AvrLpm &lpm, unsigned long interruptsQty, int msPerInterrupt, unsigned long ticksPerMs) {
+		lpm.updateSysClock(interruptsQty, msPerInterrupt, ticksPerMs);
+	}
+};
+
+}}
+
+class BenchPrint: public Butler::Arduino::Print {
+public:
+	size_t println(const char *v) { return 0; }
+	size_t write(const uint8_t buffer[], size_t size) { return size; }
+};
+
+////////// OBJECTS //////////
+Butler::Arduino::Context								gCtx;
+BenchPrint												gPrint;
+uint8_t													gCrcData[CRC_DATA_SIZE];
+char													gPayload[PAYLOAD_MAX_SIZE];
+volatile uint32_t										gSink;
+Butler::Arduino::RingBuffer<64>								gRing;
+
+////////// IMPLEMENTATION //////////
+namespace Bench {
+
+void name(const char *nameP) {
+	char c;
+	while ((c = pgm_read_byte(nameP++))) {
+		BENCH_MARKER_NAME = c;
+	}
+	BENCH_MARKER_NAME = '\0';
+}
+
+template<typename FUNC_T>
+void run(uint8_t id, const char *nameP, FUNC_T func) {
+	name(nameP);
+	BENCH_MARKER_ID = id;
+	BENCH_MARKER_STATE = BENCH_STATE_START;
+	func();
+	BENCH_MARKER_STATE = BENCH_STATE_STOP;
+}
+
+} // Bench
+
+void __attribute__((noinline)) buildMessagePayload(char* buffer, int size) {
+	// Predict buffer size
+	const int NUMBER_OF_ROOT_PARAMETERS = 3;
+	const int NUMBER_OF_SENSORS = 2;
+	const int NUMBER_OF_SENSORS_PARAMETERS = 1;
+	const int BUFFER_SIZE =
+		JSON_OBJECT_SIZE(NUMBER_OF_ROOT_PARAMETERS)								// root
+		+ JSON_ARRAY_SIZE(NUMBER_OF_SENSORS)									// data array
+		+ JSON_OBJECT_SIZE(NUMBER_OF_SENSORS_PARAMETERS)*NUMBER_OF_SENSORS;		// data array elements
+	// Allocate buffer
+	StaticJsonBuffer<BUFFER_SIZE> jsonBuffer;
+	// Encode message
+	JsonArray& data = jsonBuffer.createArray();
+	{
+		JsonObject& obj = jsonBuffer.createObject();
+		obj["temp"] = 21.5f;
+		data.add(obj);
+	}
+	{
+		JsonObject& obj = jsonBuffer.createObject();
+		obj["humid"] = 45.0f;
+		data.add(obj);
+	}
+	JsonObject& root = jsonBuffer.createObject();
+	root["v"] = 1;
+	root["id"] = "TEST_SENSOR_ID";
+	root["data"] = data;
+	// Write to buffer
+	root.printTo(buffer, size);
+}
+
+void setup() {
+	//// LOG ////
+	gCtx.logger = &gPrint;
+	//// LPM ////
+	Butler::Arduino::AvrLpmConfig config;
+	config.pinLedAwake = PIN_LED_AWAKE;
+	config.mode = Butler::Arduino::LPM_MODE_PWR_DOWN;
+	Butler::Arduino::AvrLpm lpm(config);
+	//// DATA ////
+	for (uint16_t i = 0; i < sizeof(gCrcData); ++i) {
+		gCrcData[i] = static_cast<uint8_t>(i * 31 + 7);
+	}
+	//// NO SYS CLOCK INTERRUPTS => exact measurements ////
+	TIMSK0 = 0;
+	//// BENCHMARKS ////
+	uint8_t id = 0;
+	// Keep it first, the runner subtracts the markers overhead
+	Bench::run(id++, PSTR("overhead"), []{});
+	Bench::run(id++, PSTR("crc32/continue-16"), []{
+		gSink = Butler::Arduino::Crc::crc32Continue(Butler::Arduino::Crc::crc32Begin(), gCrcData, 16);
+	});
+	Bench::run(id++, PSTR("crc32/continue-256"), []{
+		gSink = Butler::Arduino::Crc::crc32Continue(Butler::Arduino::Crc::crc32Begin(), gCrcData, sizeof(gCrcData));
+	});
+#if BUTLER_ARDUINO_CRC32_ENGINES_ALL
+	Bench::run(id++, PSTR("crc32/nibble-256"), []{
+		gSink = Butler::Arduino::Crc::crc32ContinueNibble(Butler::Arduino::Crc::crc32Begin(), gCrcData, sizeof(gCrcData));
+	});
+	Bench::run(id++, PSTR("crc32/byte-256"), []{
+		gSink = Butler::Arduino::Crc::crc32ContinueByte(Butler::Arduino::Crc::crc32Begin(), gCrcData, sizeof(gCrcData));
+	});
+	Bench::run(id++, PSTR("crc32/slicing8-256"), []{
+		gSink = Butler::Arduino::Crc::crc32ContinueSlicing8(Butler::Arduino::Crc::crc32Begin(), gCrcData, sizeof(gCrcData));
+	});
+#endif
+	Bench::run(id++, PSTR("checksum/crc8-16"), []{
+		gSink = Butler::Arduino::Crc8::calc(gCrcData, 16);
+	});
+	Bench::run(id++, PSTR("checksum/crc16-ccitt-16"), []{
+		gSink = Butler::Arduino::Crc16Ccitt::calc(gCrcData, 16);
+	});
+	Bench::run(id++, PSTR("checksum/fletcher32-16"), []{
+		gSink = Butler::Arduino::Fletcher32::calc(gCrcData, 16);
+	});
+	Bench::run(id++, PSTR("logger/logln"), []{
+		Butler::Arduino::Logger::logln_I(gCtx, BUTLER_PSTR("[config] ERROR, Wrong size: %lu"), 4096UL);
+	});
+	Bench::run(id++, PSTR("logger/logln-3-args"), []{
+		Butler::Arduino::Logger::logln_I(gCtx, BUTLER_PSTR("### Time: %.8lu Ms, Period: %.8lu Ms, rc:%i"),
+			123456UL, 60000UL, -1
+		);
+	});
+	Bench::run(id++, PSTR("logger/binary-3-args"), []{
+		Butler::Arduino::Logger::logln_B(gCtx, BUTLER_LOG_ID("### Time: %.8lu Ms, Period: %.8lu Ms, rc:%i"),
+			123456UL, 60000UL, -1
+		);
+	});
+	Bench::run(id++, PSTR("json/build-payload"), []{
+		buildMessagePayload(gPayload, sizeof(gPayload));
+	});
+	Bench::run(id++, PSTR("lpm/update-sys-clock-big"), [&]{
+		Butler::Arduino::AvrLpmBench::updateSysClock(lpm, 1000, 32, 7);
+	});
+	Bench::run(id++, PSTR("lpm/update-sys-clock-small"), [&]{
+		Butler::Arduino::AvrLpmBench::updateSysClock(lpm, 30, 1, 125);
+	});
+	Bench::run(id++, PSTR("ring/push-pop"), []{
+		uint8_t v;
+		gRing.push(static_cast<uint8_t>(gSink));
+		gRing.pop(v);
+		gSink = v;
+	});
+	Bench::run(id++, PSTR("ring/bulk-16"), []{
+		gSink = gRing.push(Butler::Arduino::ConstBufferView(gCrcData, 16));
+		gSink += gRing.pop(Butler::Arduino::BufferView(reinterpret_cast<uint8_t*>(gPayload), 16));
+	});
+	//// DONE ////
+	BENCH_MARKER_STATE = BENCH_STATE_DONE;
+	cli();
+	sleep_cpu();
+}
+
+void loop() {
+}
@@ -0,0 +1,171 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: AVR benchmarks runner.
+ *    Executes the AVR benchmarks firmware on the simavr instruction-set
+ *    simulator and reports the exact cycles count and the stack
+ *    high-water mark per benchmark.
+ *    Usage: `program [-m mcu] [-f frequency] firmware.elf`.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sim_avr.h>
+#include <sim_elf.h>
+/* Internal Includes */
+
+
+// Data space addresses of the marker registers (ATmega48/88/168/328).
+// Keep in sync with the firmware.
+#define BENCH_MARKER_STATE_ADDR							0x3E	// GPIOR0
+#define BENCH_MARKER_ID_ADDR							0x4A	// GPIOR1
+#define BENCH_MARKER_NAME_ADDR							0x4B	// GPIOR2
+
+#define BENCH_STATE_START								1
+#define BENCH_STATE_STOP								2
+#define BENCH_STATE_DONE								3
+
+#define BENCH_NAME_SIZE_MAX								48
+
+namespace {
+
+struct BenchState {
+	uint32_t											frequency = 8000000;
+	bool												active = false;
+	bool												done = false;
+	uint8_t												id = 0;
+	char												name[BENCH_NAME_SIZE_MAX + 1] = {0};
+	uint8_t												nameSize = 0;
+	avr_cycle_count_t									startCycle = 0;
+	avr_cycle_count_t									overheadCycles = 0;
+	uint16_t											startSp = 0;
+	uint16_t											minSp = 0;
+};
+
+uint16_t getSp(avr_t *avr) {
+	return avr->data[R_SPL] | (avr->data[R_SPH] << 8);
+}
+
+void onMarkerName(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+	BenchState &state = *static_cast<BenchState*>(param);
+	if (v == '\0') {
+		state.name[state.nameSize] = '\0';
+		state.nameSize = 0;
+	} else if (state.nameSize < BENCH_NAME_SIZE_MAX) {
+		state.name[state.nameSize++] = v;
+	}
+}
+
+void onMarkerId(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+	static_cast<BenchState*>(param)->id = v;
+}
+
+void onMarkerState(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+	BenchState &state = *static_cast<BenchState*>(param);
+	switch (v) {
+		case BENCH_STATE_START:
+			state.active = true;
+			state.startSp = state.minSp = getSp(avr);
+			state.startCycle = avr->cycle;
+			break;
+		case BENCH_STATE_STOP:
+		{
+			avr_cycle_count_t cycles = avr->cycle - state.startCycle;
+			state.active = false;
+			if (state.id == 0) {
+				// First benchmark measures the markers overhead
+				state.overheadCycles = cycles;
+				break;
+			}
+			cycles -= (cycles > state.overheadCycles) ? state.overheadCycles : cycles;
+			printf("%-32s %10llu %12.1f %10u\n", state.name,
+				static_cast<unsigned long long>(cycles),
+				cycles * 1000000.0 / state.frequency,
+				state.startSp - state.minSp
+			);
+		}
+			break;
+		case BENCH_STATE_DONE:
+			state.done = true;
+			break;
+		default:
+			break;
+	}
+}
+
+void usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-m mcu] [-f frequency] firmware.elf\n", program);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	BenchState state;
+	const char *mcu = "atmega328p";
+	int opt;
+	while ((opt = getopt(argc, argv, "m:f:")) != -1) {
+		switch (opt) {
+			case 'm':
+				mcu = optarg;
+				break;
+			case 'f':
+				state.frequency = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (optind >= argc) {
+		usage(argv[0]);
+		return 1;
+	}
+	// Load firmware
+	elf_firmware_t firmware;
+	memset(&firmware, 0, sizeof(firmware));
+	if (elf_read_firmware(argv[optind], &firmware)) {
+		fprintf(stderr, "ERROR, Can't load firmware: %s\n", argv[optind]);
+		return 1;
+	}
+	avr_t *avr = avr_make_mcu_by_name(mcu);
+	if (!avr) {
+		fprintf(stderr, "ERROR, Unknown MCU: %s\n", mcu);
+		return 1;
+	}
+	avr_init(avr);
+	firmware.frequency = state.frequency;
+	avr_load_firmware(avr, &firmware);
+	// Watch markers
+	avr_register_io_write(avr, BENCH_MARKER_NAME_ADDR, onMarkerName, &state);
+	avr_register_io_write(avr, BENCH_MARKER_ID_ADDR, onMarkerId, &state);
+	avr_register_io_write(avr, BENCH_MARKER_STATE_ADDR, onMarkerState, &state);
+	// Execute instruction by instruction to track the stack pointer
+	printf("%-32s %10s %12s %10s\n", "benchmark", "cycles", "us", "stack B");
+	int cpuState = cpu_Running;
+	while (!state.done && cpuState != cpu_Done && cpuState != cpu_Crashed) {
+		cpuState = avr_run(avr);
+		if (state.active) {
+			uint16_t sp = getSp(avr);
+			if (sp < state.minSp) {
+				state.minSp = sp;
+			}
+		}
+	}
+	avr_terminate(avr);
+	if (!state.done) {
+		fprintf(stderr, "ERROR, Firmware stopped unexpectedly, state: %i\n", cpuState);
+		return 1;
+	}
+	return 0;
+}
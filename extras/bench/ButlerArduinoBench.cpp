@@ -0,0 +1,567 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native micro-benchmarks of the library hot paths.
+ *    Reports the time and the heap allocations per operation.
+ *    Usage: `program [name-filter]`.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <chrono>
+/* External Includes */
+#include <MqttClient.h>
+#include <ArduinoJson.h>
+/* Internal Includes */
+#include <ButlerArduinoCrc.h>
+#include <ButlerArduinoChecksum.hpp>
+#include <ButlerArduinoTime.hpp>
+#include <ButlerArduinoContext.hpp>
+#include <ButlerArduinoPrint.hpp>
+#include <ButlerArduinoUart.hpp>
+#include <ButlerArduinoAsyncPrint.hpp>
+#include <ButlerArduinoLogger.hpp>
+#include <ButlerArduinoUtil.hpp>
+#include <ButlerArduinoStrings.hpp>
+#include <ButlerArduinoStorage.hpp>
+#include <ButlerArduinoArrayBuffer.hpp>
+#include <ButlerArduinoHeapArrayBuffer.hpp>
+#include <ButlerArduinoRingBuffer.hpp>
+#include <ButlerArduinoByteWriter.hpp>
+#include <ButlerArduinoArena.hpp>
+#include <ButlerArduinoJsonConfig.hpp>
+#include <ButlerArduinoWiFiJsonConfig.hpp>
+#include <ButlerArduinoAuthJsonConfig.hpp>
+#include <ButlerArduinoNetwork.hpp>
+#include <ButlerArduinoUartNetwork.hpp>
+#include <ButlerArduinoBufferChain.hpp>
+#include <ButlerArduinoMqtt.hpp>
+#include <ButlerArduinoMqttStack.hpp>
+#include <ButlerArduinoStaticObject.hpp>
+#include <ButlerArduinoPayloadSize.hpp>
+#include <ButlerArduinoSensorLoopOneShot.hpp>
+
+
+////////// ALLOCATIONS COUNTER //////////
+namespace {
+	unsigned long										gAllocQty = 0;
+}
+
+void* operator new(size_t size) {
+	++gAllocQty;
+	void *p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+////////// HARNESS //////////
+namespace Bench {
+
+volatile uint32_t										sink = 0;
+const char												*filter = NULL;
+
+template<typename FUNC_T>
+void run(const char *name, unsigned long iterations, FUNC_T func) {
+	if (filter && !strstr(name, filter)) {
+		return;
+	}
+	// Warm-up
+	func();
+	// Measure
+	unsigned long allocQty = gAllocQty;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned long i = 0; i < iterations; ++i) {
+		func();
+	}
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	allocQty = gAllocQty - allocQty;
+	double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+	printf("%-32s %12.1f ns/op %8.2f allocs/op\n", name,
+		ns / iterations, static_cast<double>(allocQty) / iterations
+	);
+}
+
+} // Bench
+
+////////// OBJECTS DECLARATION //////////
+class BenchClock: public Butler::Arduino::Time::Clock, public MqttClient::System {
+public:
+	unsigned long millis() const {
+		return ::millis();
+	}
+};
+
+class BenchPrint: public Butler::Arduino::Print {
+public:
+	size_t println(const char *v) {
+		size_t len = strlen(v);
+		Bench::sink += len;
+		return len;
+	}
+
+	size_t write(const uint8_t buffer[], size_t size) {
+		Bench::sink += size;
+		return size;
+	}
+};
+
+/** UART with the 64 bytes TX FIFO that is always empty */
+class BenchUart: public Butler::Arduino::Uart {
+public:
+	void setTimeout(unsigned long) {}
+	size_t readBytes(char*, size_t) { return 0; }
+	size_t write(uint8_t) { Bench::sink++; return 1; }
+	size_t write(const uint8_t buffer[], size_t size) { Bench::sink += size; return size; }
+	size_t print(const char c[]) { return write(reinterpret_cast<const uint8_t*>(c), strlen(c)); }
+	size_t println(const char c[]) { return print(c) + 2; }
+	void flush() {}
+	int availableForWrite() { return 64; }
+	int available(void) { return 0; }
+};
+
+class BenchStorage: public Butler::Arduino::Storage {
+public:
+	uint32_t size() { return mData.size(); }
+	uint32_t readSize() { return mLength; }
+
+	bool read(Butler::Arduino::Buffer &buffer) {
+		memcpy(buffer.get(), mData.get(), Butler::Arduino::min(mLength, buffer.size()));
+		return true;
+	}
+
+	void write(const Butler::Arduino::Buffer &buffer) {
+		mLength = Butler::Arduino::min(buffer.size(), mData.size());
+		memcpy(mData.get(), buffer.get(), mLength);
+	}
+
+	void reset() { mLength = 0; }
+private:
+	Butler::Arduino::ArrayBuffer<1024>					mData;
+	uint32_t											mLength = 0;
+};
+
+/** Replies to CONNECT and SUBSCRIBE like a MQTT broker does. */
+class BenchBrokerNetwork: public Butler::Arduino::Network {
+public:
+	int connect(const char* hostname, int port) { return 0; }
+
+	int read(unsigned char* buffer, int len, unsigned long timeoutMs) {
+		int qty = Butler::Arduino::min(len, mReplySize - mReplyIdx);
+		memcpy(buffer, mReply + mReplyIdx, qty);
+		mReplyIdx += qty;
+		return qty;
+	}
+
+	int write(unsigned char* buffer, int len, unsigned long timeoutMs) {
+		switch (buffer[0] & 0xF0) {
+			case 0x10: // CONNECT => CONNACK
+			{
+				const unsigned char reply[] = {0x20, 0x02, 0x00, 0x00};
+				setReply(reply, sizeof(reply));
+			}
+				break;
+			case 0x80: // SUBSCRIBE => SUBACK
+			{
+				int idx = 1;
+				while (buffer[idx++] & 0x80);
+				const unsigned char reply[] = {0x90, 0x03, buffer[idx], buffer[idx + 1], 0x00};
+				setReply(reply, sizeof(reply));
+			}
+				break;
+			default:
+				break;
+		}
+		return len;
+	}
+
+	int disconnect() { return 0; }
+private:
+	unsigned char										mReply[8];
+	int													mReplySize = 0;
+	int													mReplyIdx = 0;
+
+	void setReply(const unsigned char *reply, int size) {
+		memcpy(mReply, reply, size);
+		mReplySize = size;
+		mReplyIdx = 0;
+	}
+};
+
+struct BenchAppJsonConfig: public Butler::Arduino::Config::JsonConfigNode {
+	uint32_t											period = (1*60*1000L);
+
+	bool decode(JsonObject &json) {
+		bool updated = false;
+		if (json.containsKey(Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD))) {
+			uint32_t v = json[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD)];
+			if (v != period) {
+				period = v;
+				updated = true;
+			}
+		}
+		return updated;
+	}
+
+	void encode(JsonObject &json, JsonBuffer &jsonBuffer) {
+		json[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PERIOD)] = period;
+	}
+};
+
+struct BenchJsonConfig: public Butler::Arduino::Config::JsonConfig<3> {
+	Butler::Arduino::Config::WiFiJsonConfig				wifi;
+	Butler::Arduino::Config::AuthJsonConfig				auth;
+	BenchAppJsonConfig									app;
+
+	BenchJsonConfig() {
+		addNode(Butler::Arduino::Strings::WIFI, wifi);
+		addNode(Butler::Arduino::Strings::AUTH, auth);
+		addNode(Butler::Arduino::Strings::APP, app);
+		wifi.ssid = "butler-network";
+		wifi.passphrase = "butler-passphrase";
+		auth.fingerprints[0] = "A1 B2 C3 D4 E5 F6 07 18 29 3A 4B 5C 6D 7E 8F 90 A1 B2 C3 D4";
+		auth.token = "0123456789abcdef0123456789abcdef01234567";
+	}
+};
+
+////////// PAYLOAD //////////
+typedef Butler::Arduino::Payload::SensorPayload<
+	sizeof("5CCF7F000001") - 1, 2, 5, Butler::Arduino::Payload::floatWidth(3, 1)
+> BenchPayload;
+
+////////// OBJECTS //////////
+BenchClock												gClock;
+BenchPrint												gPrint;
+Butler::Arduino::Context								gCtx;
+
+////////// IMPLEMENTATION //////////
+void buildMessagePayload(char* buffer, int size) {
+	StaticJsonBuffer<BenchPayload::JSON_BUFFER_SIZE> jsonBuffer;
+	// Encode message
+	JsonArray &data = jsonBuffer.createArray();
+	{
+		JsonObject &obj = jsonBuffer.createObject();
+		obj[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_TEMPERATURE)] = 21.5f;
+		data.add(obj);
+	}
+	{
+		JsonObject &obj = jsonBuffer.createObject();
+		obj[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_SENSOR_DATA_TYPE_HUMIDITY)] = 45.0f;
+		data.add(obj);
+	}
+	JsonObject &root = jsonBuffer.createObject();
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_VERSION)] = 1;
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_ID)] = "5CCF7F000001";
+	root[Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PAYLOAD_KEY_DATA)] = data;
+	// Write to buffer
+	root.printTo(buffer, size);
+}
+
+void buildMessagePayloadChain(Butler::Arduino::BufferChainBase& chain, const Butler::Arduino::CharBufferView& scratch) {
+	buildMessagePayload(scratch.get(), scratch.size());
+	chain.add(Butler::Arduino::ConstBufferView(
+		reinterpret_cast<const uint8_t*>(scratch.get()), strlen(scratch.get()) + 1
+	));
+}
+
+void processMessageConfig(MqttClient::MessageData& md) {}
+
+void benchCrc() {
+	static uint8_t data[4096];
+	for (uint32_t i = 0; i < sizeof(data); ++i) {
+		data[i] = static_cast<uint8_t>(i * 31 + 7);
+	}
+	Bench::run("crc32/rtc-512", 20000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32(data, 512);
+	});
+	Bench::run("crc32/sector-4096", 2000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32(data, sizeof(data));
+	});
+	Bench::run("crc32/cstr", 200000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32("butler/sensor/5CCF7F000001/data");
+	});
+#if BUTLER_ARDUINO_CRC32_ENGINES_ALL
+	Bench::run("crc32/nibble-4096", 500, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32ContinueNibble(Butler::Arduino::Crc::crc32Begin(), data, sizeof(data));
+	});
+	Bench::run("crc32/byte-4096", 2000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32ContinueByte(Butler::Arduino::Crc::crc32Begin(), data, sizeof(data));
+	});
+	Bench::run("crc32/slicing8-4096", 2000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32ContinueSlicing8(Butler::Arduino::Crc::crc32Begin(), data, sizeof(data));
+	});
+#if BUTLER_ARDUINO_CRC32_CLMUL_SUPPORTED
+	Bench::run("crc32/clmul-4096", 20000, [&]{
+		Bench::sink += Butler::Arduino::Crc::crc32ContinueClmul(Butler::Arduino::Crc::crc32Begin(), data, sizeof(data));
+	});
+#endif
+#endif
+#if BUTLER_ARDUINO_CRC32_BULK
+	// Device images verification, 64 sectors per call
+	static Butler::Arduino::Crc::Crc32Job jobs[64];
+	for (uint32_t i = 0; i < 64; ++i) {
+		jobs[i].data = data;
+		jobs[i].len = sizeof(data);
+	}
+	Bench::run("crc32/bulk-64x4096-1t", 500, [&]{
+		Butler::Arduino::Crc::crc32Bulk(jobs, 64, 1);
+		Bench::sink += jobs[63].crc;
+	});
+	Bench::run("crc32/bulk-64x4096", 500, [&]{
+		Butler::Arduino::Crc::crc32Bulk(jobs, 64);
+		Bench::sink += jobs[63].crc;
+	});
+#endif
+}
+
+void benchChecksum() {
+	static uint8_t data[512];
+	for (uint32_t i = 0; i < sizeof(data); ++i) {
+		data[i] = static_cast<uint8_t>(i * 31 + 7);
+	}
+	Bench::run("checksum/crc8-512", 20000, [&]{
+		Bench::sink += Butler::Arduino::Crc8::calc(data, sizeof(data));
+	});
+	Bench::run("checksum/crc16-ccitt-512", 20000, [&]{
+		Bench::sink += Butler::Arduino::Crc16Ccitt::calc(data, sizeof(data));
+	});
+	Bench::run("checksum/crc32-512", 20000, [&]{
+		Bench::sink += Butler::Arduino::Crc32::calc(data, sizeof(data));
+	});
+	Bench::run("checksum/fletcher32-512", 20000, [&]{
+		Bench::sink += Butler::Arduino::Fletcher32::calc(data, sizeof(data));
+	});
+}
+
+void benchTime() {
+	Bench::run("time/timer", 1000000, [&]{
+		Butler::Arduino::Time::Timer timer(gClock, 1000);
+		Bench::sink += timer.expired() + timer.leftMs();
+	});
+}
+
+void benchLogger() {
+	Bench::run("logger/logln", 200000, [&]{
+		Butler::Arduino::Logger::logln_I(gCtx, BUTLER_PSTR("[config] ERROR, Wrong size: %lu"), 4096UL);
+	});
+	static char longStr[301];
+	memset(longStr, 'x', sizeof(longStr) - 1);
+	longStr[sizeof(longStr) - 1] = '\0';
+	Bench::run("logger/logln-long", 50000, [&]{
+		Butler::Arduino::Logger::logln_I_long(gCtx, BUTLER_PSTR("[config] %s"), longStr);
+	});
+	Bench::run("logger/binary", 1000000, [&]{
+		Butler::Arduino::Logger::logln_B(gCtx, BUTLER_LOG_ID("[config] ERROR, Wrong size: %lu"), 4096UL);
+	});
+	Bench::run("logger/binary-long", 50000, [&]{
+		Butler::Arduino::Logger::logln_B_long(gCtx, BUTLER_LOG_ID("[config] %s"), longStr);
+	});
+	static BenchUart uart;
+	static Butler::Arduino::AsyncPrint<> asyncPrint(uart);
+	Bench::run("logger/async-println", 1000000, [&]{
+		asyncPrint.println("[config] ERROR, Wrong size: 4096");
+	});
+	Bench::run("logger/async-println-long", 50000, [&]{
+		asyncPrint.println(longStr);
+	});
+	asyncPrint.flush();
+}
+
+void benchUtil() {
+	const String mac("5C:CF:7F:00:00:01");
+	const uint8_t macBin[6] = {0x5C, 0xCF, 0x7F, 0x00, 0x00, 0x01};
+	const String addr("butler");
+	const String nameSpace("butler");
+	const String group("sensor");
+	const String id("5CCF7F000001");
+	Bench::run("util/mac-to-hex", 200000, [&]{
+		Bench::sink += Butler::Arduino::Util::macAddressToHex(mac).length();
+	});
+	Bench::run("util/mac-to-hex-buffer", 1000000, [&]{
+		char out[Butler::Arduino::Util::MAC_ADDRESS_HEX_SIZE];
+		Bench::sink += Butler::Arduino::Util::macAddressToHex(macBin, out)[0];
+	});
+	Bench::run("util/make-url", 200000, [&]{
+		Bench::sink += Butler::Arduino::Util::makeUrl(Butler::Arduino::Strings::URL_MODEL_CERT, addr, 8043).length();
+	});
+	Bench::run("util/make-url-buffer", 1000000, [&]{
+		char out[96];
+		Bench::sink += Butler::Arduino::Util::makeUrl(Butler::Arduino::CharBufferView(out, sizeof(out)),
+			Butler::Arduino::Strings::URL_MODEL_CERT, "butler", 8043,
+			Butler::Arduino::Strings::CERT_FORM_DER, Butler::Arduino::Strings::CERT_TYPE_CRT
+		);
+	});
+	Bench::run("util/make-topic", 200000, [&]{
+		Bench::sink += Butler::Arduino::Util::makeTopic(Butler::Arduino::Strings::TOPIC_MODEL_DATA,
+			nameSpace, group, id
+		).length();
+	});
+	Bench::run("util/make-topic-buffer", 1000000, [&]{
+		char out[64];
+		Bench::sink += Butler::Arduino::Util::makeTopic(Butler::Arduino::CharBufferView(out, sizeof(out)),
+			PSTR(BUTLER_ARDUINO_TOPIC_MODEL_DATA("butler", "sensor", "<id>")), NULL, NULL, "5CCF7F000001"
+		);
+	});
+}
+
+void benchBuffer() {
+	Bench::run("buffer/array-128", 1000000, [&]{
+		Butler::Arduino::ArrayBuffer<128> buffer;
+		buffer.get()[0] = 1;
+		Bench::sink += buffer.get()[0] + buffer.size();
+	});
+	Bench::run("buffer/heap-128", 1000000, [&]{
+		Butler::Arduino::HeapArrayBuffer buffer(128);
+		buffer.get()[0] = 1;
+		Bench::sink += buffer.get()[0] + buffer.size();
+	});
+	Butler::Arduino::HeapArrayBuffer buffer(256);
+	Bench::run("buffer/heap-resize", 1000000, [&]{
+		buffer.resize(128 + (Bench::sink & 0x7F));
+		Bench::sink += buffer.size();
+	});
+	Butler::Arduino::ByteWriter writer;
+	Bench::run("writer/printf", 1000000, [&]{
+		writer.clear();
+		Bench::sink += writer.printf("### Time: %.8lu Ms, rc:%i", 123456UL, -1);
+	});
+	Butler::Arduino::RingBuffer<128> ring;
+	Bench::run("ring/push-pop", 1000000, [&]{
+		uint8_t v = 0;
+		ring.push(static_cast<uint8_t>(Bench::sink));
+		ring.pop(v);
+		Bench::sink += v;
+	});
+	uint8_t data[64] = {0};
+	Bench::run("ring/bulk-64", 1000000, [&]{
+		Bench::sink += ring.push(Butler::Arduino::ConstBufferView(data, sizeof(data)));
+		Bench::sink += ring.pop(Butler::Arduino::BufferView(data, sizeof(data)));
+	});
+}
+
+void benchJsonConfig() {
+	BenchJsonConfig config;
+	BenchStorage storage;
+	Bench::run("json-config/store", 50000, [&]{
+		config.store(gCtx, storage);
+	});
+	Butler::Arduino::ByteWriter writer;
+	Bench::run("json-config/store-reuse", 50000, [&]{
+		config.store(gCtx, storage, writer);
+	});
+	Bench::run("json-config/load", 50000, [&]{
+		Bench::sink += config.load(gCtx, storage);
+	});
+	const char stored[] = "{\"wifi\":{\"ssid\":\"butler-network\"},\"app\":{\"period\":120000}}";
+	Butler::Arduino::ArrayBuffer<256> packet;
+	Bench::run("json-config/load-view", 50000, [&]{
+		// Config is a sub-range of a bigger buffer
+		Butler::Arduino::BufferView json = packet.view().slice(16, sizeof(stored));
+		memcpy(json.get(), stored, sizeof(stored));
+		Bench::sink += config.load(gCtx, json);
+	});
+	Butler::Arduino::Arena arena;
+	arena.begin(2048);
+	gCtx.arena = &arena;
+	Bench::run("json-config/load-arena", 50000, [&]{
+		Bench::sink += config.load(gCtx, storage);
+	});
+	gCtx.arena = NULL;
+	Bench::run("arena/alloc-4x64", 1000000, [&]{
+		Butler::Arduino::ArenaScope scope(&arena);
+		for (int i = 0; i < 4; ++i) {
+			Bench::sink += (arena.alloc(64) != NULL);
+		}
+	});
+	const char update[] = "{\"app\":{\"period\":120000}}";
+	Bench::run("json-config/update", 100000, [&]{
+		char json[sizeof(update)];
+		memcpy(json, update, sizeof(update));
+		Bench::sink += config.update(gCtx, json);
+	});
+}
+
+void benchLoop() {
+	BenchBrokerNetwork network;
+	MqttClient::Options options;
+	options.commandTimeoutMs = 1000;
+	Butler::Arduino::StaticObject<
+		Butler::Arduino::MqttStack<BenchPrint, MqttClient::NetworkImpl<Butler::Arduino::Network>, 128, 128>
+	> mqttStack;
+	MqttClient &mqtt = mqttStack.create(options, gClock, gPrint, network).getClient();
+	Butler::Arduino::LoopContext lCtx;
+	Butler::Arduino::LoopConstants lConst;
+	lCtx.mqtt = &mqtt;
+	lCtx.publishPeriodMs = 60000;
+	lConst.id = "5CCF7F000001";
+	lConst.keepAlivePeriodSec = 120;
+	lConst.publishPayloadMaxSize = BenchPayload::SIZE;
+	lConst.publishTopic = "butler/sensor/5CCF7F000001/data";
+	lConst.configTopic = "butler/sensor/5CCF7F000001/config";
+	lConst.configListenPeriodMs = 0;
+	lConst.buildMessagePayload = buildMessagePayload;
+	lConst.processConfigMessage = processMessageConfig;
+	Butler::Arduino::Loop::setup(gCtx, lCtx, lConst);
+	Bench::run("loop/one-shot", 20000, [&]{
+		Bench::sink += Butler::Arduino::Loop::loop(gCtx, lCtx, lConst);
+		mqtt.disconnect();
+	});
+	lCtx.network = &network;
+	lConst.buildMessagePayloadChain = buildMessagePayloadChain;
+	Bench::run("loop/one-shot-chain", 20000, [&]{
+		Bench::sink += Butler::Arduino::Loop::loop(gCtx, lCtx, lConst);
+		mqtt.disconnect();
+	});
+	const char payload[] = "{\"id\":\"5CCF7F000001\",\"data\":[{\"t\":21.5},{\"h\":40}]}";
+	Butler::Arduino::BufferChain<2> chain;
+	chain.add(Butler::Arduino::ConstBufferView(reinterpret_cast<const uint8_t*>(payload), sizeof(payload)));
+	Bench::run("mqtt/publish-chain", 1000000, [&]{
+		Bench::sink += Butler::Arduino::Mqtt::publish(network, lConst.publishTopic, chain, false, 1000);
+	});
+	static BenchUart uart;
+	Butler::Arduino::UartNetwork uartNetwork(uart);
+	uint8_t frame[128];
+	memset(frame, 0x5A, sizeof(frame));
+	Bench::run("network/uart-write-128", 1000000, [&]{
+		Bench::sink += uartNetwork.write(frame, sizeof(frame), 1000);
+	});
+	Bench::run("network/uart-write-chain", 1000000, [&]{
+		Bench::sink += uartNetwork.write(chain, 1000);
+	});
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1) {
+		Bench::filter = argv[1];
+	}
+	gCtx.time = &gClock;
+	gCtx.logger = &gPrint;
+	benchCrc();
+	benchChecksum();
+	benchTime();
+	benchLogger();
+	benchUtil();
+	benchBuffer();
+	benchJsonConfig();
+	benchLoop();
+	return 0;
+}
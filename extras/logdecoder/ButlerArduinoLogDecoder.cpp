@@ -0,0 +1,338 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Binary log decoder.
+ *    Restores the text of the records written by `Logger::logln_B`
+ *    using the format strings from the firmware ELF file.
+ *    The bytes out of the records are printed as is.
+ *    Usage: `program firmware.elf [log.bin]`, the log is read from
+ *    the standard input by default, e.g. from the serial port.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+/* Internal Includes */
+
+
+// Keep in sync with `LoggerPrivate::Binary`
+#define LOG_SYNC										0xA5
+#define LOG_HEADER_SIZE									8	// ID and time
+#define LOG_KIND_INT									1
+#define LOG_KIND_UINT									2
+#define LOG_KIND_FLOAT									3
+#define LOG_KIND_STR									4
+#define LOG_KIND_PTR									5
+
+namespace {
+
+//////////////////////////////////// ELF ////////////////////////////////////////
+
+const uint32_t ELF_SHF_ALLOC							= 0x2;
+const uint32_t ELF_SHT_NOBITS							= 8;
+
+struct Section {
+	uint64_t											addr;
+	uint64_t											offset;
+	uint64_t											size;
+};
+
+struct Firmware {
+	std::vector<uint8_t>								data;
+	std::vector<Section>								sections;
+};
+
+uint64_t readLe(const uint8_t *p, uint8_t size) {
+	uint64_t v = 0;
+	for (uint8_t i = 0; i < size; i++) {
+		v |= static_cast<uint64_t>(p[i]) << (8 * i);
+	}
+	return v;
+}
+
+bool readFile(const char *name, std::vector<uint8_t> &data) {
+	FILE *f = fopen(name, "rb");
+	if (!f) {
+		return false;
+	}
+	uint8_t buf[4096];
+	size_t qty;
+	while ((qty = fread(buf, 1, sizeof(buf), f)) > 0) {
+		data.insert(data.end(), buf, buf + qty);
+	}
+	fclose(f);
+	return true;
+}
+
+/** Loads the allocated sections of the little-endian ELF32/ELF64 file */
+bool loadFirmware(const char *name, Firmware &fw) {
+	if (!readFile(name, fw.data)) {
+		return false;
+	}
+	const std::vector<uint8_t> &d = fw.data;
+	if (d.size() < 52 || memcmp(d.data(), "\x7f" "ELF", 4) || d[5] != 1) {
+		return false;
+	}
+	const bool is64 = d[4] == 2;
+	const uint8_t addrSize = is64 ? 8 : 4;
+	const uint64_t shoff = readLe(&d[is64 ? 0x28 : 0x20], addrSize);
+	const uint16_t shentsize = readLe(&d[is64 ? 0x3A : 0x2E], 2);
+	const uint16_t shnum = readLe(&d[is64 ? 0x3C : 0x30], 2);
+	for (uint16_t i = 0; i < shnum; i++) {
+		const uint64_t sh = shoff + static_cast<uint64_t>(i) * shentsize;
+		if (sh + shentsize > d.size()) {
+			return false;
+		}
+		const uint32_t type = readLe(&d[sh + 4], 4);
+		const uint64_t flags = readLe(&d[sh + 8], addrSize);
+		Section s;
+		s.addr = readLe(&d[sh + 8 + addrSize], addrSize);
+		s.offset = readLe(&d[sh + 8 + 2 * addrSize], addrSize);
+		s.size = readLe(&d[sh + 8 + 3 * addrSize], addrSize);
+		if ((flags & ELF_SHF_ALLOC) && type != ELF_SHT_NOBITS && s.offset + s.size <= d.size()) {
+			fw.sections.push_back(s);
+		}
+	}
+	return true;
+}
+
+/** Gets the string placed at the address by the firmware */
+const char* findString(const Firmware &fw, uint64_t addr) {
+	for (size_t i = 0; i < fw.sections.size(); i++) {
+		const Section &s = fw.sections[i];
+		if (addr >= s.addr && addr < s.addr + s.size) {
+			const char *str = reinterpret_cast<const char*>(&fw.data[s.offset + (addr - s.addr)]);
+			// Must be terminated inside the section
+			if (memchr(str, '\0', s.addr + s.size - addr)) {
+				return str;
+			}
+		}
+	}
+	return NULL;
+}
+
+//////////////////////////////////// FORMAT /////////////////////////////////////
+
+struct Arg {
+	uint8_t												kind;
+	uint8_t												size;
+	uint64_t											raw;
+	std::string											str;
+};
+
+bool parseArgs(const uint8_t *p, size_t size, std::vector<Arg> &args) {
+	size_t i = 0;
+	while (i < size) {
+		Arg a;
+		a.kind = p[i] >> 4;
+		a.size = p[i] & 0x0F;
+		i++;
+		if (a.kind == LOG_KIND_STR) {
+			if (i >= size || i + 1 + p[i] > size) {
+				return false;
+			}
+			a.size = p[i];
+			a.str.assign(reinterpret_cast<const char*>(p + i + 1), a.size);
+			a.raw = 0;
+			i += 1 + a.size;
+		} else {
+			if (!a.size || a.size > 8 || i + a.size > size) {
+				return false;
+			}
+			a.raw = readLe(p + i, a.size);
+			i += a.size;
+		}
+		args.push_back(a);
+	}
+	return true;
+}
+
+int64_t toSigned(const Arg &a) {
+	if (a.kind == LOG_KIND_FLOAT) {
+		return 0;
+	}
+	const uint8_t bits = a.size * 8;
+	if (bits < 64 && (a.raw >> (bits - 1)) & 1) {
+		return static_cast<int64_t>(a.raw | (~0ULL << bits));
+	}
+	return static_cast<int64_t>(a.raw);
+}
+
+double toDouble(const Arg &a) {
+	if (a.kind != LOG_KIND_FLOAT) {
+		return a.kind == LOG_KIND_INT ? toSigned(a) : a.raw;
+	}
+	if (a.size == sizeof(float)) {
+		uint32_t raw = a.raw;
+		float v;
+		memcpy(&v, &raw, sizeof(v));
+		return v;
+	}
+	double v;
+	memcpy(&v, &a.raw, sizeof(v));
+	return v;
+}
+
+/** Formats like `printf`, the argument size is taken from the record */
+std::string format(const char *fmt, const std::vector<Arg> &args) {
+	std::string out;
+	size_t argIdx = 0;
+	char buf[256];
+	while (*fmt) {
+		if (*fmt != '%') {
+			out += *fmt++;
+			continue;
+		}
+		if (fmt[1] == '%') {
+			out += '%';
+			fmt += 2;
+			continue;
+		}
+		std::string spec = "%";
+		fmt++;
+		while (*fmt && strchr("-+ #0", *fmt)) {
+			spec += *fmt++;
+		}
+		while (*fmt && (isdigit(*fmt) || *fmt == '.' || *fmt == '*')) {
+			if (*fmt == '*') {
+				spec += std::to_string(argIdx < args.size() ? toSigned(args[argIdx++]) : 0);
+				fmt++;
+			} else {
+				spec += *fmt++;
+			}
+		}
+		// The size is known from the record
+		while (*fmt && strchr("hlLqjzt", *fmt)) {
+			fmt++;
+		}
+		const char conv = *fmt;
+		if (!conv) {
+			break;
+		}
+		fmt++;
+		if (argIdx >= args.size()) {
+			out += "<?>";
+			continue;
+		}
+		const Arg &a = args[argIdx++];
+		if (strchr("di", conv)) {
+			snprintf(buf, sizeof(buf), (spec + "lld").c_str(), static_cast<long long>(toSigned(a)));
+		} else if (strchr("ouxX", conv)) {
+			snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(), static_cast<unsigned long long>(a.raw));
+		} else if (conv == 'c') {
+			snprintf(buf, sizeof(buf), (spec + 'c').c_str(), static_cast<int>(a.raw));
+		} else if (strchr("eEfFgGaA", conv)) {
+			snprintf(buf, sizeof(buf), (spec + conv).c_str(), toDouble(a));
+		} else if (conv == 's') {
+			snprintf(buf, sizeof(buf), (spec + 's').c_str(), a.kind == LOG_KIND_STR ? a.str.c_str() : "<?>");
+		} else if (conv == 'p') {
+			snprintf(buf, sizeof(buf), "0x%0*llx", a.size * 2, static_cast<unsigned long long>(a.raw));
+		} else {
+			snprintf(buf, sizeof(buf), "<%%%c?>", conv);
+		}
+		out += buf;
+	}
+	return out;
+}
+
+//////////////////////////////////// DECODER ////////////////////////////////////
+
+/** Decodes the record, returns `false` if the bytes are not a valid record */
+bool decodeRecord(const Firmware &fw, const uint8_t *p, size_t size) {
+	if (size < LOG_HEADER_SIZE) {
+		return false;
+	}
+	const uint32_t id = readLe(p, 4);
+	const uint32_t time = readLe(p + 4, 4);
+	std::vector<Arg> args;
+	if (!parseArgs(p + LOG_HEADER_SIZE, size - LOG_HEADER_SIZE, args)) {
+		return false;
+	}
+	std::string text;
+	if (id == 0) {
+		text = "<" + std::to_string(args.empty() ? 0 : args[0].raw) + " records dropped>";
+	} else {
+		const char *fmt = findString(fw, id);
+		if (!fmt) {
+			return false;
+		}
+		text = format(fmt, args);
+	}
+	printf("[%6lu.%03lu] %s\n", static_cast<unsigned long>(time / 1000), static_cast<unsigned long>(time % 1000),
+		text.c_str()
+	);
+	return true;
+}
+
+/** Gets the bytes quantity to decide if the pending bytes start a record */
+size_t getRequiredSize(const std::vector<uint8_t> &pending) {
+	if (pending.empty() || pending[0] != LOG_SYNC) {
+		return 1;
+	}
+	return pending.size() < 2 ? 2 : 2 + pending[1];
+}
+
+void usage(const char *program) {
+	fprintf(stderr, "Usage: %s firmware.elf [log.bin]\n", program);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+	Firmware fw;
+	if (!loadFirmware(argv[1], fw)) {
+		fprintf(stderr, "ERROR, Can't load firmware: %s\n", argv[1]);
+		return 1;
+	}
+	FILE *in = stdin;
+	if (argc > 2 && !(in = fopen(argv[2], "rb"))) {
+		fprintf(stderr, "ERROR, Can't open log: %s\n", argv[2]);
+		return 1;
+	}
+	std::vector<uint8_t> pending;
+	bool eof = false;
+	for (;;) {
+		int c;
+		while (!eof && pending.size() < getRequiredSize(pending)) {
+			if ((c = fgetc(in)) == EOF) {
+				eof = true;
+			} else {
+				pending.push_back(c);
+			}
+		}
+		if (pending.empty()) {
+			break;
+		}
+		size_t consumed = 1;
+		if (pending[0] == LOG_SYNC && pending.size() >= 2 && pending.size() >= getRequiredSize(pending)
+			&& decodeRecord(fw, pending.data() + 2, pending[1]))
+		{
+			consumed = 2 + pending[1];
+		} else {
+			// Not a record, e.g. the boot messages
+			fputc(pending[0], stdout);
+		}
+		pending.erase(pending.begin(), pending.begin() + consumed);
+		fflush(stdout);
+	}
+	if (in != stdin) {
+		fclose(in);
+	}
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino core.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <chrono>
+#include <thread>
+/* Internal Includes */
+#include "Arduino.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock						Clock;
+
+const Clock::time_point& startTime() {
+	static const Clock::time_point start = Clock::now();
+	return start;
+}
+
+} // namespace
+
+#if defined(__GLIBC__) && (__GLIBC__ == 2) && (__GLIBC_MINOR__ < 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size) {
+	size_t len = strlen(src);
+	if (size) {
+		size_t n = (len >= size) ? size - 1 : len;
+		memcpy(dst, src, n);
+		dst[n] = '\0';
+	}
+	return len;
+}
+#endif
+
+unsigned long millis() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime()).count();
+}
+
+unsigned long micros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime()).count();
+}
+
+void delay(unsigned long ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+	std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {}
+
+int digitalRead(uint8_t pin) {
+	return HIGH;
+}
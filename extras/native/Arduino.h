@@ -0,0 +1,61 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino core.
+ *    Provides just enough of the core API to build the portable part
+ *    of the library on the host.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_NATIVE_ARDUINO_H_
+#define BUTLER_ARDUINO_NATIVE_ARDUINO_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+/* Internal Includes */
+#include "pgmspace.h"
+#include "WString.h"
+#include "Print.h"
+
+
+#define HIGH											0x1
+#define LOW												0x0
+
+#define INPUT											0x0
+#define OUTPUT											0x1
+#define INPUT_PULLUP									0x2
+
+typedef uint8_t											byte;
+typedef bool											boolean;
+
+#if defined(__GLIBC__) && (__GLIBC__ == 2) && (__GLIBC_MINOR__ < 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+/** Milliseconds since the first call. */
+unsigned long millis();
+
+/** Microseconds since the first call. */
+unsigned long micros();
+
+void delay(unsigned long ms);
+
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+
+void digitalWrite(uint8_t pin, uint8_t val);
+
+int digitalRead(uint8_t pin);
+
+#endif // BUTLER_ARDUINO_NATIVE_ARDUINO_H_
@@ -0,0 +1,50 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino Print class.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_NATIVE_PRINT_H_
+#define BUTLER_ARDUINO_NATIVE_PRINT_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "WString.h"
+
+
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t) = 0;
+
+	virtual size_t write(const uint8_t *buffer, size_t size) {
+		size_t n = 0;
+		while (size-- && write(*buffer++)) {
+			++n;
+		}
+		return n;
+	}
+
+	size_t write(const char *str) { return str ? write(reinterpret_cast<const uint8_t*>(str), strlen(str)) : 0; }
+
+	size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+	size_t print(const char *str) { return write(str); }
+	size_t print(const String &str) { return write(reinterpret_cast<const uint8_t*>(str.c_str()), str.length()); }
+
+	size_t println() { return write("\r\n"); }
+	size_t println(const char *str) { size_t n = print(str); return n + println(); }
+	size_t println(const String &str) { size_t n = print(str); return n + println(); }
+};
+
+#endif // BUTLER_ARDUINO_NATIVE_PRINT_H_
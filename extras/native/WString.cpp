@@ -0,0 +1,189 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino String class.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <string.h>
+/* Internal Includes */
+#include "WString.h"
+
+
+String::String(const char *cstr): mBuf(NULL), mCapacity(0), mLen(0) {
+	if (cstr) copy(cstr, strlen(cstr));
+}
+
+String::String(const String &str): mBuf(NULL), mCapacity(0), mLen(0) {
+	copy(str.c_str(), str.length());
+}
+
+String::String(String &&str): mBuf(NULL), mCapacity(0), mLen(0) {
+	move(str);
+}
+
+String::String(char c): mBuf(NULL), mCapacity(0), mLen(0) {
+	copy(&c, 1);
+}
+
+String::String(int value, unsigned char base): mBuf(NULL), mCapacity(0), mLen(0) {
+	bool negative = (value < 0 && base == DEC);
+	fromNumber(negative ? -(long)value : (unsigned int)value, negative, base);
+}
+
+String::String(unsigned int value, unsigned char base): mBuf(NULL), mCapacity(0), mLen(0) {
+	fromNumber(value, false, base);
+}
+
+String::String(long value, unsigned char base): mBuf(NULL), mCapacity(0), mLen(0) {
+	bool negative = (value < 0 && base == DEC);
+	fromNumber(negative ? -value : (unsigned long)value, negative, base);
+}
+
+String::String(unsigned long value, unsigned char base): mBuf(NULL), mCapacity(0), mLen(0) {
+	fromNumber(value, false, base);
+}
+
+String::~String() {
+	delete[] mBuf;
+}
+
+String& String::operator=(const String &rhs) {
+	if (this != &rhs) copy(rhs.c_str(), rhs.length());
+	return *this;
+}
+
+String& String::operator=(String &&rhs) {
+	if (this != &rhs) move(rhs);
+	return *this;
+}
+
+String& String::operator=(const char *cstr) {
+	if (cstr) copy(cstr, strlen(cstr));
+	else invalidate();
+	return *this;
+}
+
+bool String::reserve(unsigned int size) {
+	if (mBuf && mCapacity >= size) return true;
+	if (changeBuffer(size)) {
+		if (mLen == 0) mBuf[0] = '\0';
+		return true;
+	}
+	return false;
+}
+
+bool String::concat(const char *cstr) {
+	return cstr ? concat(cstr, strlen(cstr)) : false;
+}
+
+bool String::concat(const char *cstr, unsigned int length) {
+	unsigned int newLen = mLen + length;
+	if (!cstr) return false;
+	if (length == 0) return true;
+	if (!reserve(newLen)) return false;
+	memmove(mBuf + mLen, cstr, length);
+	mLen = newLen;
+	mBuf[mLen] = '\0';
+	return true;
+}
+
+bool String::equals(const String &str) const {
+	return mLen == str.mLen && strcmp(c_str(), str.c_str()) == 0;
+}
+
+bool String::equals(const char *cstr) const {
+	return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+	if (fromIndex >= mLen) return -1;
+	const char *p = strchr(mBuf + fromIndex, ch);
+	return p ? p - mBuf : -1;
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const {
+	if (fromIndex >= mLen) return -1;
+	const char *p = strstr(mBuf + fromIndex, str.c_str());
+	return p ? p - mBuf : -1;
+}
+
+void String::replace(const String &find, const String &replace) {
+	if (mLen == 0 || find.length() == 0) return;
+	String res;
+	const char *cur = mBuf;
+	const char *found;
+	while ((found = strstr(cur, find.c_str())) != NULL) {
+		res.concat(cur, found - cur);
+		res.concat(replace);
+		cur = found + find.length();
+	}
+	if (cur == mBuf) return;
+	res.concat(cur);
+	move(res);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+	if (index >= mLen) return;
+	if (count > mLen - index) count = mLen - index;
+	memmove(mBuf + index, mBuf + index + count, mLen - index - count);
+	mLen -= count;
+	mBuf[mLen] = '\0';
+}
+
+void String::invalidate() {
+	delete[] mBuf;
+	mBuf = NULL;
+	mCapacity = mLen = 0;
+}
+
+bool String::changeBuffer(unsigned int size) {
+	char *buf = new char[size + 1];
+	if (mBuf) {
+		memcpy(buf, mBuf, mLen + 1);
+		delete[] mBuf;
+	}
+	mBuf = buf;
+	mCapacity = size;
+	return true;
+}
+
+String& String::copy(const char *cstr, unsigned int length) {
+	if (!reserve(length)) {
+		invalidate();
+		return *this;
+	}
+	mLen = length;
+	memmove(mBuf, cstr, length);
+	mBuf[mLen] = '\0';
+	return *this;
+}
+
+void String::move(String &rhs) {
+	delete[] mBuf;
+	mBuf = rhs.mBuf;
+	mCapacity = rhs.mCapacity;
+	mLen = rhs.mLen;
+	rhs.mBuf = NULL;
+	rhs.mCapacity = rhs.mLen = 0;
+}
+
+void String::fromNumber(unsigned long value, bool negative, unsigned char base) {
+	char buf[2 + 8 * sizeof(unsigned long)];
+	char *p = &buf[sizeof(buf) - 1];
+	*p = '\0';
+	do {
+		unsigned long digit = value % base;
+		*--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+		value /= base;
+	} while (value);
+	if (negative) *--p = '-';
+	copy(p, &buf[sizeof(buf) - 1] - p);
+}
@@ -0,0 +1,96 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino String class.
+ *    Keeps the Arduino behavior: the buffer lives on the heap and is
+ *    reallocated on every growth.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_NATIVE_WSTRING_H_
+#define BUTLER_ARDUINO_NATIVE_WSTRING_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+/* Internal Includes */
+
+
+#define DEC												10
+#define HEX												16
+
+class __FlashStringHelper;
+#define FPSTR(p)										(reinterpret_cast<const __FlashStringHelper*>(p))
+#define F(s)											FPSTR(PSTR(s))
+
+class String {
+public:
+	String(const char *cstr = "");
+	String(const __FlashStringHelper *str): String(reinterpret_cast<const char*>(str)) {}
+	String(const String &str);
+	String(String &&str);
+	explicit String(char c);
+	explicit String(int value, unsigned char base = DEC);
+	explicit String(unsigned int value, unsigned char base = DEC);
+	explicit String(long value, unsigned char base = DEC);
+	explicit String(unsigned long value, unsigned char base = DEC);
+	~String();
+
+	String& operator=(const String &rhs);
+	String& operator=(String &&rhs);
+	String& operator=(const char *cstr);
+
+	bool reserve(unsigned int size);
+	unsigned int length() const { return mLen; }
+	const char* c_str() const { return mBuf ? mBuf : ""; }
+	char* begin() { return mBuf; }
+	char* end() { return mBuf + mLen; }
+	char charAt(unsigned int index) const { return index < mLen ? mBuf[index] : 0; }
+	char operator[](unsigned int index) const { return charAt(index); }
+
+	bool concat(const String &str) { return concat(str.c_str(), str.length()); }
+	bool concat(const char *cstr);
+	bool concat(const char *cstr, unsigned int length);
+	bool concat(char c) { return concat(&c, 1); }
+	bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char*>(str)); }
+	String& operator+=(const String &rhs) { concat(rhs); return *this; }
+	String& operator+=(const char *cstr) { concat(cstr); return *this; }
+	String& operator+=(char c) { concat(c); return *this; }
+	String& operator+=(const __FlashStringHelper *str) { concat(str); return *this; }
+
+	bool equals(const String &str) const;
+	bool equals(const char *cstr) const;
+	bool operator==(const String &rhs) const { return equals(rhs); }
+	bool operator==(const char *cstr) const { return equals(cstr); }
+	bool operator!=(const String &rhs) const { return !equals(rhs); }
+	bool operator!=(const char *cstr) const { return !equals(cstr); }
+
+	int indexOf(char ch, unsigned int fromIndex = 0) const;
+	int indexOf(const String &str, unsigned int fromIndex = 0) const;
+
+	void replace(const String &find, const String &replace);
+	void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+
+private:
+	char												*mBuf;
+	unsigned int										mCapacity;
+	unsigned int										mLen;
+
+	void invalidate();
+	bool changeBuffer(unsigned int size);
+	String& copy(const char *cstr, unsigned int length);
+	void move(String &rhs);
+	void fromNumber(unsigned long value, bool negative, unsigned char base);
+};
+
+inline String operator+(const String &lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+inline String operator+(const String &lhs, const char *rhs) { String s(lhs); s += rhs; return s; }
+inline String operator+(const char *lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+
+#endif // BUTLER_ARDUINO_NATIVE_WSTRING_H_
@@ -0,0 +1,116 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native mock of the Arduino program memory API.
+ *    Program memory is a regular memory on the host.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_NATIVE_PGMSPACE_H_
+#define BUTLER_ARDUINO_NATIVE_PGMSPACE_H_
+
+/* System Includes */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+/* Internal Includes */
+
+
+#define PROGMEM
+#define PGM_P											const char*
+#define PSTR(s)											(s)
+
+typedef uint8_t											prog_uint8_t;
+typedef uint16_t										prog_uint16_t;
+typedef uint32_t										prog_uint32_t;
+
+/**
+ * Non-zero tag keeps the program memory in a separate "address space":
+ * the flash bytes are stored XOR-ed by the tag, so a RAM read of them gives garbage.
+ * Used by the tests to catch the RAM and flash pointers mix-up.
+ */
+#ifndef BUTLER_ARDUINO_NATIVE_PGM_TAG
+	#define BUTLER_ARDUINO_NATIVE_PGM_TAG				0
+#endif
+
+#if BUTLER_ARDUINO_NATIVE_PGM_TAG
+
+#define pgm_read_byte(addr)								(uint8_t(*reinterpret_cast<const uint8_t*>(addr) ^ BUTLER_ARDUINO_NATIVE_PGM_TAG))
+#define pgm_read_byte_near(addr)						pgm_read_byte(addr)
+
+inline size_t strlen_P(const char *p) {
+	size_t res = 0;
+	while (pgm_read_byte(p + res)) {
+		res++;
+	}
+	return res;
+}
+
+inline char* strncpy_P(char *dst, const char *p, size_t size) {
+	size_t i = 0;
+	for (; i < size && pgm_read_byte(p + i); i++) {
+		dst[i] = pgm_read_byte(p + i);
+	}
+	for (; i < size; i++) {
+		dst[i] = '\0';
+	}
+	return dst;
+}
+
+inline char* strcpy_P(char *dst, const char *p) {
+	return strncpy_P(dst, p, strlen_P(p) + 1);
+}
+
+inline int strncmp_P(const char *s, const char *p, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		const uint8_t c = pgm_read_byte(p + i);
+		if (uint8_t(s[i]) != c) {
+			return uint8_t(s[i]) - c;
+		}
+		if (!c) {
+			break;
+		}
+	}
+	return 0;
+}
+
+inline int strcmp_P(const char *s, const char *p) {
+	return strncmp_P(s, p, SIZE_MAX);
+}
+
+/** Stores the string in the tagged form, the result is the flash pointer */
+inline const char* pgmStore(char *dst, const char *s) {
+	size_t i = 0;
+	do {
+		dst[i] = s[i] ^ BUTLER_ARDUINO_NATIVE_PGM_TAG;
+	} while (s[i++]);
+	return dst;
+}
+
+#else
+
+#define pgm_read_byte(addr)								(*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr)								(*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr)							(*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_byte_near(addr)						pgm_read_byte(addr)
+#define pgm_read_word_near(addr)						pgm_read_word(addr)
+#define pgm_read_dword_near(addr)						pgm_read_dword(addr)
+
+#define memcpy_P										memcpy
+#define strcpy_P										strcpy
+#define strncpy_P										strncpy
+#define strlen_P										strlen
+#define strcmp_P										strcmp
+#define strncmp_P										strncmp
+#define snprintf_P										snprintf
+#define vsnprintf_P										vsnprintf
+
+#endif
+
+#endif // BUTLER_ARDUINO_NATIVE_PGMSPACE_H_
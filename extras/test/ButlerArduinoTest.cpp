@@ -0,0 +1,113 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Host-native tests of the program memory handling.
+ *    The flash strings are kept in a separate "address space"
+ *    (see `BUTLER_ARDUINO_NATIVE_PGM_TAG`), so a RAM read of the flash
+ *    pointer gives garbage like on the target.
+ *    Returns non-zero exit code on failure.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+/* Internal Includes */
+#include <ButlerArduinoModel.hpp>
+#include <ButlerArduinoUtil.hpp>
+
+
+#if !BUTLER_ARDUINO_NATIVE_PGM_TAG
+	#error The test requires the tagged program memory
+#endif
+
+////////// HARNESS //////////
+namespace Test {
+
+int														failures = 0;
+
+void check(bool ok, const char *name) {
+	printf("%-40s %s\n", name, ok ? "OK" : "FAIL");
+	if (!ok) {
+		failures++;
+	}
+}
+
+/** Keeps the flash strings of the test */
+class Flash {
+public:
+	Flash(): mQty(0) {}
+
+	const char* operator()(const char *s) {
+		const char *res = pgmStore(mData + mQty, s);
+		mQty += strlen(s) + 1;
+		return res;
+	}
+private:
+	char												mData[512];
+	size_t												mQty;
+};
+
+}
+
+////////// TESTS //////////
+void testModel() {
+	Test::Flash flash;
+	const char *modelP = flash("https://<host>:<port>/<id>/cfg");
+	const Butler::Arduino::Model::Key keys[] = {
+		{flash("<id>"), "5CCF7F000001", false},
+		{flash("<host>"), flash("butler"), true},
+		{flash("<port>"), "8443", false}
+	};
+	const uint8_t keysQty = sizeof(keys) / sizeof(keys[0]);
+	char out[64];
+	uint32_t len = Butler::Arduino::Model::expand(modelP, keys, keysQty, Butler::Arduino::CharBufferView(out, sizeof(out)));
+	Test::check(!strcmp(out, "https://butler:8443/5CCF7F000001/cfg") && len == strlen(out), "model/expand");
+	// Truncated
+	len = Butler::Arduino::Model::expand(modelP, keys, keysQty, Butler::Arduino::CharBufferView(out, 10));
+	Test::check(!strcmp(out, "https://b") && len == strlen("https://butler:8443/5CCF7F000001/cfg"), "model/expand-truncated");
+	// No value => the key is kept, unknown key is kept
+	const Butler::Arduino::Model::Key later[] = {
+		{flash("<id>"), NULL, false},
+		{flash("<host>"), "h", false}
+	};
+	Butler::Arduino::Model::expand(flash("<host>/<id>/<x>"), later, 2, Butler::Arduino::CharBufferView(out, sizeof(out)));
+	Test::check(!strcmp(out, "h/<id>/<x>"), "model/expand-keep");
+}
+
+void testUtil() {
+	Test::Flash flash;
+	const char *modelP = flash("<id>/data");
+	const Butler::Arduino::Model::Key keys[] = {
+		{flash("<id>"), "5CCF7F000001", false}
+	};
+	char out[18];
+	bool ok = Butler::Arduino::Util::expandModel(Butler::Arduino::CharBufferView(out, sizeof(out)), modelP, keys, 1);
+	Test::check(ok && !strcmp(out, "5CCF7F000001/data"), "util/expand-model");
+	ok = Butler::Arduino::Util::expandModel(Butler::Arduino::CharBufferView(out, sizeof(out) - 1), modelP, keys, 1);
+	Test::check(!ok, "util/expand-model-no-fit");
+}
+
+void testStrings() {
+	Test::Flash flash;
+	Butler::Arduino::Strings::RamString<4> fits(flash("abc"));
+	Test::check(!strcmp(fits, "abc") && !fits.truncated(), "strings/ram-fits");
+	Butler::Arduino::Strings::RamString<4> shorter(flash("a"));
+	Test::check(!strcmp(shorter, "a") && !shorter.truncated(), "strings/ram-short");
+	Butler::Arduino::Strings::RamString<4> longer(flash("abcd"));
+	Test::check(!strcmp(longer, "abc") && longer.truncated(), "strings/ram-truncated");
+}
+
+int main() {
+	testModel();
+	testUtil();
+	testStrings();
+	return Test::failures ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Arena allocator implementation.
+ *    Monotonic allocator over one block allocated at boot.
+ *    Used for the temporary JSON and byte buffers.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_ARENA_H_
+#define BUTLER_ARDUINO_ARENA_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+/* Internal Includes */
+#include "ButlerArduinoBuffer.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * Allocations just move the offset, nothing is freed individually.
+ * Use `ArenaScope` to release everything allocated during the phase.
+ */
+class Arena {
+public:
+	Arena(): mBuf(NULL), mSize(0), mUsed(0), mPeak(0) {}
+
+	~Arena() { delete[] mBuf; }
+
+	/** Allocates the block. Must be called once at boot. */
+	bool begin(uint32_t size) {
+		if (mBuf) {
+			return false;
+		}
+		mBuf = new uint8_t[size];
+		mSize = mBuf ? size : 0;
+		return mBuf != NULL;
+	}
+
+	/** Returns `NULL` if there is no space */
+	void* alloc(size_t size) {
+		uint32_t offset = align(mUsed);
+		if (!mBuf || offset > mSize || size > mSize - offset) {
+			return NULL;
+		}
+		mUsed = offset + size;
+		if (mUsed > mPeak) {
+			mPeak = mUsed;
+		}
+		return mBuf + offset;
+	}
+
+	/** Releases everything */
+	void reset() { mUsed = 0; }
+
+	/** Gets the current offset to return to it later */
+	uint32_t mark() const { return mUsed; }
+
+	/** Releases everything allocated after the mark */
+	void rewind(uint32_t mark) {
+		if (mark < mUsed) {
+			mUsed = mark;
+		}
+	}
+
+	uint32_t size() const { return mSize; }
+
+	uint32_t used() const { return mUsed; }
+
+	/** Gets the maximum used size since boot */
+	uint32_t peak() const { return mPeak; }
+
+private:
+	uint8_t												*mBuf;
+	uint32_t											mSize;
+	uint32_t											mUsed;
+	uint32_t											mPeak;
+
+	static uint32_t align(uint32_t v) {
+		return (v + sizeof(void*) - 1) & ~static_cast<uint32_t>(sizeof(void*) - 1);
+	}
+
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+};
+
+/** Rewinds the arena on destruction. Accepts `NULL`. */
+class ArenaScope {
+public:
+	ArenaScope(Arena *arena): mArena(arena), mMark(arena ? arena->mark() : 0) {}
+
+	~ArenaScope() {
+		if (mArena) {
+			mArena->rewind(mMark);
+		}
+	}
+
+	Arena* arena() const { return mArena; }
+
+private:
+	Arena												*mArena;
+	uint32_t											mMark;
+
+	ArenaScope(const ArenaScope&);
+	ArenaScope& operator=(const ArenaScope&);
+};
+
+/**
+ * Temporary buffer from the arena, falls back to the heap
+ * if there is no arena or no space.
+ * The arena space is released on destruction.
+ */
+struct ArenaBuffer: public Buffer {
+	ArenaBuffer(Arena *arena, uint32_t size)
+		: mScope(arena), mSize(size), mHeap(NULL),
+		mBuf(arena ? static_cast<uint8_t*>(arena->alloc(size)) : NULL)
+	{
+		if (!mBuf) {
+			mBuf = mHeap = new uint8_t[size];
+		}
+	}
+
+	~ArenaBuffer() { delete[] mHeap; }
+
+	uint8_t* get() { return mBuf; }
+	const uint8_t* get() const { return mBuf; }
+	uint32_t size() const { return mSize; }
+
+private:
+	ArenaScope											mScope;
+	uint32_t											mSize;
+	uint8_t												*mHeap;
+	uint8_t												*mBuf;
+
+	ArenaBuffer(const ArenaBuffer&);
+	ArenaBuffer& operator=(const ArenaBuffer&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_ARENA_H_
@@ -0,0 +1,56 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Arena JSON buffer implementation.
+ *    ArduinoJson buffer allocating from the context arena.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_ARENA_JSON_BUFFER_H_
+#define BUTLER_ARDUINO_ARENA_JSON_BUFFER_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <ArduinoJson.h>
+/* Internal Includes */
+#include "ButlerArduinoContext.hpp"
+#include "ButlerArduinoArena.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * Allocates from `Context::arena` and releases the space on destruction.
+ * Works like the `DynamicJsonBuffer` if the context has no arena
+ * or the arena is exhausted (e.g. the config bigger than the arena).
+ * Don't allocate from the buffer while a nested arena scope is open.
+ */
+class ArenaJsonBuffer: public ArduinoJson::Internals::JsonBufferBase<ArenaJsonBuffer> {
+public:
+	ArenaJsonBuffer(Context &ctx): mScope(ctx.arena) {}
+
+	void* alloc(size_t size) {
+		if (mScope.arena()) {
+			void *res = mScope.arena()->alloc(size);
+			if (res) {
+				return res;
+			}
+		}
+		return mHeap.alloc(size);
+	}
+
+private:
+	ArenaScope											mScope;
+	DynamicJsonBuffer									mHeap;
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_ARENA_JSON_BUFFER_H_
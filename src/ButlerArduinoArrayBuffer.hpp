@@ -36,6 +36,10 @@ struct ArrayBuffer: public ArrayBufferBase<uint8_t, BUFFER_SIZE>, public Buffer
 	uint8_t* get() { return ArrayBufferBase<uint8_t, BUFFER_SIZE>::get(); }
 	const uint8_t* get() const { return ArrayBufferBase<uint8_t, BUFFER_SIZE>::get(); }
 	uint32_t size() const { return ArrayBufferBase<uint8_t, BUFFER_SIZE>::size(); }
+	BufferView view() { return Buffer::view(); }
+	ConstBufferView view() const { return Buffer::view(); }
+	operator BufferView() { return view(); }
+	operator ConstBufferView() const { return view(); }
 };
 
 template<uint32_t BUFFER_SIZE = 100>
@@ -0,0 +1,115 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Asynchronous print implementation.
+ *    Keeps the log lines in RAM and passes them to the UART without blocking.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_ASYNC_PRINT_H_
+#define BUTLER_ARDUINO_ASYNC_PRINT_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoPrint.hpp"
+#include "ButlerArduinoUart.hpp"
+#include "ButlerArduinoRingBuffer.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * The line is copied to the ring buffer, then moved to the UART TX buffer
+ * only as much as `Uart::availableForWrite` allows, so the caller never
+ * waits for the bytes to leave the FIFO. The UART TX-empty interrupt of
+ * the Arduino core sends them while the network and sensor work continues.
+ * The rest is moved on the next print or `poll`.
+ * `flush` writes everything and waits the transmission end, the `Lpm`
+ * calls it (via `LOG_FLUSH`) before the sleep.
+ * The oldest bytes are written synchronously if the buffer is full,
+ * nothing is dropped.
+ */
+template<uint32_t BUFFER_SIZE = 128>
+class AsyncPrint: public Print {
+public:
+	using Print::write;
+
+	AsyncPrint(Uart &uart): mUart(uart) {}
+
+	size_t println(const char *v) {
+		const size_t size = strlen(v);
+		push(reinterpret_cast<const uint8_t*>(v), size);
+		push(reinterpret_cast<const uint8_t*>("\r\n"), 2);
+		poll();
+		return size + 2;
+	}
+
+	size_t write(const uint8_t buffer[], size_t size) {
+		push(buffer, size);
+		poll();
+		return size;
+	}
+
+	/** Moves the bytes to the UART without blocking */
+	void poll() {
+		int qty = mUart.availableForWrite();
+		if (qty > 0) {
+			drain(qty);
+		}
+	}
+
+	void flush() {
+		drain(mBuffer.size());
+		mUart.flush();
+	}
+
+	/** Gets the maximum bytes quantity waiting for the UART at once */
+	uint32_t highWaterMark() const { return mBuffer.highWaterMark(); }
+
+private:
+	Uart												&mUart;
+	RingBuffer<BUFFER_SIZE>								mBuffer;
+
+	void push(const uint8_t *data, size_t size) {
+		for (;;) {
+			const uint32_t qty = mBuffer.push(ConstBufferView(data, size));
+			data += qty;
+			size -= qty;
+			if (!size) {
+				break;
+			}
+			// Full => make the room
+			drain(size < BUFFER_SIZE ? size : BUFFER_SIZE);
+		}
+	}
+
+	void drain(uint32_t qty) {
+		uint8_t chunk[16];
+		while (qty) {
+			const uint32_t chunkSize = mBuffer.peek(BufferView(chunk, qty < sizeof(chunk) ? qty : sizeof(chunk)));
+			if (!chunkSize) {
+				break;
+			}
+			mUart.write(chunk, chunkSize);
+			mBuffer.skip(chunkSize);
+			qty -= chunkSize;
+		}
+	}
+
+	AsyncPrint(const AsyncPrint&);
+	AsyncPrint& operator=(const AsyncPrint&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_ASYNC_PRINT_H_
@@ -32,7 +32,7 @@ struct AuthJsonConfig: public JsonConfigNode, public AuthConfig<> {
 		bool updated = false;
 		// FINGERPRINTS
 		{
-			JsonArray &o = json[Strings::FINGERPRINTS];
+			JsonArray &o = json[Strings::flash(Strings::FINGERPRINTS)];
 			if (JsonArray::invalid() != o) {
 				uint8_t idx = 0;
 				// Set new values
@@ -55,7 +55,7 @@ struct AuthJsonConfig: public JsonConfigNode, public AuthConfig<> {
 		}
 		// TOKEN
 		{
-			const char* v = json[Strings::TOKEN];
+			const char* v = json[Strings::flash(Strings::TOKEN)];
 			if (v && !token.equals(v)) {
 				token = v;
 				updated = true;
@@ -73,11 +73,11 @@ struct AuthJsonConfig: public JsonConfigNode, public AuthConfig<> {
 					o.add(fingerprints[i].c_str());
 				}
 			}
-			json[Strings::FINGERPRINTS] = o;
+			json[Strings::flash(Strings::FINGERPRINTS)] = o;
 		}
 		// TOKEN
 		if (token.length()) {
-			json[Strings::TOKEN] = token.c_str();
+			json[Strings::flash(Strings::TOKEN)] = token.c_str();
 		}
 	}
 
@@ -22,6 +22,7 @@
 /* Internal Includes */
 #include "ButlerArduinoAvrLpm.hpp"
 #include "ButlerArduinoTime.hpp"
+#include "ButlerArduinoLogger.hpp"
 
 
 #define LPM_CLOCK_PRESCALER_1024	(_BV (CS20) | _BV (CS21) | _BV (CS22))
@@ -95,9 +96,17 @@ AvrLpm::AvrLpm(const AvrLpmConfig& config)
 }
 
 void AvrLpm::idle(unsigned long ms) {
+	if (mConfig.ctx) {
+		LOG_FLUSH(*mConfig.ctx);
+	}
+	// The bits are shifted by Timer1 => no sleep in the middle of the frame
+	const bool keepTimer1 = mConfig.uart && mUartAwake;
+	if (mConfig.uart) {
+		mConfig.uart->flush();
+	}
 	unsigned long start = millis();
 	while (ms > 0) {
-		if (ms >= 16 && mConfig.mode == LPM_MODE_PWR_DOWN) {
+		if (ms >= 16 && mConfig.mode == LPM_MODE_PWR_DOWN && !keepTimer1) {
 			stopSysClock();
 			// setup the WDT
 			unsigned int prescaler = calcWdtPrescaler(ms);
@@ -130,7 +139,8 @@ void AvrLpm::idle(unsigned long ms) {
 			// go to low power
 			digitalWrite(mConfig.pinLedAwake, LOW);
 			{
-				switch(mConfig.mode) {
+				// The power save stops the clock of Timer1
+				switch(keepTimer1 ? LPM_MODE_IDLE : mConfig.mode) {
 					case LPM_MODE_PWR_SAVE:
 						set_sleep_mode(SLEEP_MODE_PWR_SAVE);
 						break;
@@ -145,7 +155,9 @@ void AvrLpm::idle(unsigned long ms) {
 				power_spi_disable();
 				power_usart0_disable();
 				power_timer0_disable();
-				power_timer1_disable();
+				if (!keepTimer1) {
+					power_timer1_disable();
+				}
 				// power_timer2_disable()	// used to keep time tracking
 				power_twi_disable();
 				sei();
@@ -18,6 +18,8 @@
 #include <stdint.h>
 /* Internal Includes */
 #include "ButlerArduinoLpm.hpp"
+#include "ButlerArduinoContext.hpp"
+#include "ButlerArduinoUart.hpp"
 
 
 namespace Butler {
@@ -32,15 +34,30 @@ enum AvrLpmMode {
 struct AvrLpmConfig {
 	uint8_t												pinLedAwake;
 	AvrLpmMode											mode;
+	/** Optional, the logger is flushed before the sleep */
+	Context												*ctx = NULL;
+	/**
+	 * Optional, the UART clocked by Timer1 (`AvrSwUart`): the TX is flushed
+	 * before the sleep and Timer1 is kept running while the UART is awake
+	 * (only the IDLE sleep), see `AvrLpm::setUartAwake`
+	 */
+	Uart												*uart = NULL;
 };
 
 class AvrLpm: public Lpm {
 public:
 	AvrLpm(const AvrLpmConfig&);
 	void idle(unsigned long ms);
+
+	/** The peer of `AvrLpmConfig::uart` might send, e.g. not hibernated */
+	void setUartAwake(bool awake) { mUartAwake = awake; }
 private:
+	/** Benchmarks the clock math. See `extras/avrbench`. */
+	friend struct AvrLpmBench;
+
 	AvrLpmConfig										mConfig;
 	uint8_t												clock_0_TIMSK = 0;
+	bool												mUartAwake = true;
 
 	void resetLpmClock();
 	void stopLpmClock();
@@ -0,0 +1,293 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Interrupt driven software UART for AVR implementation.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifdef __AVR__
+
+/* System Includes */
+#include <Arduino.h>
+#include <string.h>
+#include <avr/interrupt.h>
+/* Internal Includes */
+#include "ButlerArduinoAvrSwUart.hpp"
+#include "ButlerArduinoTime.hpp"
+#include "ButlerArduinoRingBuffer.hpp"
+
+
+#define AVR_SW_UART_TIMER_PRESCALER_1			(_BV (CS10))
+#define AVR_SW_UART_TIMER_INTERRUPTS			(_BV (OCIE1A) | _BV (OCIE1B))
+// Delay before the first TX bit, long enough to set the compare before the match
+#define AVR_SW_UART_TX_START_TICKS				64
+
+namespace Butler {
+namespace Arduino {
+
+namespace {
+
+AvrSwUartBase											*gInstance = NULL;
+
+}
+
+AvrSwUartBase::AvrSwUartBase(const AvrSwUartConfig &config, uint8_t *rxBuf, uint8_t rxSize, uint8_t *txBuf, uint8_t txSize)
+: mRxBuf(rxBuf), mRxMask(rxSize - 1), mRxHead(0), mRxTail(0),
+  mTxBuf(txBuf), mTxMask(txSize - 1), mTxHead(0), mTxTail(0),
+  mRxBitIdx(0), mRxByte(0), mTxFrame(0), mTxActive(false), mTimeoutMs(1000)
+{
+	memset(&mStats, 0, sizeof(mStats));
+	// The timer tick is the CPU cycle
+	mBitTicks = (F_CPU + config.speed / 2) / config.speed;
+	// The first data bit is sampled in the middle
+	mStartTicks = mBitTicks + mBitTicks / 2;
+	// TX idles high
+	pinMode(config.transmitPin, OUTPUT);
+	digitalWrite(config.transmitPin, HIGH);
+	mTxPortReg = portOutputRegister(digitalPinToPort(config.transmitPin));
+	mTxPinMask = digitalPinToBitMask(config.transmitPin);
+	// RX
+	pinMode(config.receivePin, INPUT_PULLUP);
+	mRxPinReg = portInputRegister(digitalPinToPort(config.receivePin));
+	mRxPinMask = digitalPinToBitMask(config.receivePin);
+	mPcMaskReg = digitalPinToPCMSK(config.receivePin);
+	mPcMaskBit = _BV(digitalPinToPCMSKbit(config.receivePin));
+	mPcCtrlBit = _BV(digitalPinToPCICRbit(config.receivePin));
+	noInterrupts();
+	gInstance = this;
+	// Free-running, the compare values are moved forward by the bit time
+	TIMSK1 &= ~AVR_SW_UART_TIMER_INTERRUPTS;
+	TCCR1A = 0;
+	TCCR1B = AVR_SW_UART_TIMER_PRESCALER_1;
+	// Wait the start bit
+	PCIFR = mPcCtrlBit;
+	*mPcMaskReg |= mPcMaskBit;
+	PCICR |= mPcCtrlBit;
+	interrupts();
+}
+
+AvrSwUartBase::~AvrSwUartBase() {
+	flush();
+	noInterrupts();
+	*mPcMaskReg &= ~mPcMaskBit;
+	TIMSK1 &= ~AVR_SW_UART_TIMER_INTERRUPTS;
+	gInstance = NULL;
+	interrupts();
+}
+
+size_t AvrSwUartBase::readBytes(char *buffer, size_t length) {
+	size_t n = 0;
+	unsigned long start = millis();
+	while (n < length) {
+		const uint8_t tail = mRxTail;
+		if (mRxHead != tail) {
+			BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+			buffer[n++] = mRxBuf[tail & mRxMask];
+			BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+			mRxTail = tail + 1;
+			// Like `Stream` the timeout is per byte
+			start = millis();
+		} else if (Time::calcTimeElapsed(millis(), start) >= mTimeoutMs) {
+			break;
+		}
+	}
+	return n;
+}
+
+size_t AvrSwUartBase::write(uint8_t c) {
+	return write(&c, 1);
+}
+
+size_t AvrSwUartBase::write(const uint8_t buffer[], size_t size) {
+	for (size_t i = 0; i < size; ++i) {
+		const uint8_t head = mTxHead;
+		while (uint8_t(head - mTxTail) > mTxMask) {
+			// Full => send and wait the interrupt
+			startTx();
+		}
+		mTxBuf[head & mTxMask] = buffer[i];
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		mTxHead = head + 1;
+	}
+	startTx();
+	return size;
+}
+
+size_t AvrSwUartBase::print(const char c[]) {
+	return write(reinterpret_cast<const uint8_t*>(c), strlen(c));
+}
+
+size_t AvrSwUartBase::println(const char c[]) {
+	return print(c) + write(reinterpret_cast<const uint8_t*>("\r\n"), 2);
+}
+
+void AvrSwUartBase::flush() {
+	while (mTxActive) {
+		// Wait the interrupt
+	}
+}
+
+int AvrSwUartBase::availableForWrite() {
+	return mTxMask + 1 - uint8_t(mTxHead - mTxTail);
+}
+
+int AvrSwUartBase::available(void) {
+	return uint8_t(mRxHead - mRxTail);
+}
+
+AvrSwUartStats AvrSwUartBase::getStats() const {
+	noInterrupts();
+	AvrSwUartStats res = mStats;
+	interrupts();
+	return res;
+}
+
+void AvrSwUartBase::resetStats() {
+	noInterrupts();
+	memset(&mStats, 0, sizeof(mStats));
+	interrupts();
+}
+
+void AvrSwUartBase::startTx() {
+	noInterrupts();
+	if (!mTxActive && mTxHead != mTxTail) {
+		mTxActive = true;
+		mTxFrame = 0;
+		OCR1B = TCNT1 + AVR_SW_UART_TX_START_TICKS;
+		TIFR1 = _BV (OCF1B);
+		TIMSK1 |= _BV (OCIE1B);
+	}
+	interrupts();
+}
+
+// The handlers are inlined to the vectors, no calls => short prologue.
+// The timer is read first on the edge and the pin is read first on the compare,
+// so the entry latencies compensate each other.
+
+inline __attribute__((always_inline)) void AvrSwUartBase::onPinChange() {
+	const uint16_t now = TCNT1;
+	AvrSwUartBase *self = gInstance;
+	if (self && !self->mRxBitIdx && !(*self->mRxPinReg & self->mRxPinMask)) {
+		OCR1A = now + self->mStartTicks;
+		TIFR1 = _BV (OCF1A);
+		TIMSK1 |= _BV (OCIE1A);
+		// No interrupts from the data bits edges
+		*self->mPcMaskReg &= ~self->mPcMaskBit;
+		self->mRxBitIdx = 1;
+	}
+}
+
+inline __attribute__((always_inline)) void AvrSwUartBase::onRxBit() {
+	AvrSwUartBase *self = gInstance;
+	const uint8_t level = *self->mRxPinReg & self->mRxPinMask;
+	const uint8_t idx = self->mRxBitIdx;
+	if (idx <= 8) {
+		// Data bits, LSB first
+		self->mRxByte = (self->mRxByte >> 1) | (level ? 0x80 : 0);
+		self->mRxBitIdx = idx + 1;
+		OCR1A += self->mBitTicks;
+		return;
+	}
+	// Stop bit
+	TIMSK1 &= ~_BV (OCIE1A);
+	if (!level) {
+		self->mStats.framingErrors++;
+	} else {
+		const uint8_t head = self->mRxHead;
+		const uint8_t qty = head - self->mRxTail;
+		if (qty > self->mRxMask) {
+			self->mStats.overruns++;
+		} else {
+			self->mRxBuf[head & self->mRxMask] = self->mRxByte;
+			BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+			self->mRxHead = head + 1;
+			if (qty + 1 > self->mStats.rxHighWaterMark) {
+				self->mStats.rxHighWaterMark = qty + 1;
+			}
+		}
+	}
+	self->mRxBitIdx = 0;
+	// Wait the next start bit
+	PCIFR = self->mPcCtrlBit;
+	*self->mPcMaskReg |= self->mPcMaskBit;
+}
+
+inline __attribute__((always_inline)) void AvrSwUartBase::onTxBit() {
+	AvrSwUartBase *self = gInstance;
+	const uint16_t frame = self->mTxFrame;
+	if (frame) {
+		// Data bits LSB first, then the stop bit
+		if (frame & 1) {
+			*self->mTxPortReg |= self->mTxPinMask;
+		} else {
+			*self->mTxPortReg &= ~self->mTxPinMask;
+		}
+		self->mTxFrame = frame >> 1;
+		OCR1B += self->mBitTicks;
+		return;
+	}
+	// The stop bit is sent
+	const uint8_t tail = self->mTxTail;
+	if (self->mTxHead != tail) {
+		// Start bit
+		*self->mTxPortReg &= ~self->mTxPinMask;
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		self->mTxFrame = self->mTxBuf[tail & self->mTxMask] | 0x100;
+		self->mTxTail = tail + 1;
+		OCR1B += self->mBitTicks;
+	} else {
+		TIMSK1 &= ~_BV (OCIE1B);
+		self->mTxActive = false;
+	}
+}
+
+}}
+
+// Weak => the sketch that does not use the UART still might own the vectors
+// (e.g. `SoftwareSerial` behind `SwUart`)
+
+#ifdef PCINT0_vect
+ISR (PCINT0_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onPinChange();
+}
+#endif
+
+#ifdef PCINT1_vect
+ISR (PCINT1_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onPinChange();
+}
+#endif
+
+#ifdef PCINT2_vect
+ISR (PCINT2_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onPinChange();
+}
+#endif
+
+#ifdef PCINT3_vect
+ISR (PCINT3_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onPinChange();
+}
+#endif
+
+ISR (TIMER1_COMPA_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onRxBit();
+}
+
+ISR (TIMER1_COMPB_vect, __attribute__((weak)))
+{
+	Butler::Arduino::AvrSwUartBase::onTxBit();
+}
+
+#endif // __AVR__
@@ -0,0 +1,139 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Interrupt driven software UART for AVR.
+ *    Start bit by the pin change interrupt, bits timing by the Timer1 compare.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_AVR_SW_UART_H_
+#define BUTLER_ARDUINO_AVR_SW_UART_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+/* Internal Includes */
+#include "ButlerArduinoUart.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+struct AvrSwUartConfig {
+	uint32_t											speed;
+	uint8_t												receivePin;
+	uint8_t												transmitPin;
+};
+
+struct AvrSwUartStats {
+	/** Bytes with the low stop bit, dropped */
+	uint16_t											framingErrors;
+	/** Bytes received while the RX ring is full, dropped */
+	uint16_t											overruns;
+	/** Maximum bytes quantity waiting in the RX ring */
+	uint8_t												rxHighWaterMark;
+};
+
+/**
+ * Unlike `SoftwareSerial` the interrupts are never disabled for the byte time,
+ * every bit is a short interrupt, so the receiving and the transmitting run
+ * at once and the other interrupts (`millis`, `HardwareSerial`) are served.
+ * The free-running Timer1 is taken (no PWM on pins 9 and 10, no `Servo`),
+ * compare A samples the RX bits, compare B shifts the TX bits out.
+ * Only one instance might exist. The RX pin must support the pin change interrupt.
+ * 38400 bit/s is reliable at 8 MHz while the link is used in turns (MQTT request
+ * then response), the full duplex at this speed needs 16 MHz.
+ */
+class AvrSwUartBase: public Uart {
+public:
+	using Uart::write;
+
+	~AvrSwUartBase();
+
+	void setTimeout(unsigned long timeout) { mTimeoutMs = timeout; }
+
+	size_t readBytes(char *buffer, size_t length);
+
+	size_t write(uint8_t c);
+
+	size_t write(const uint8_t buffer[], size_t size);
+
+	size_t print(const char c[]);
+
+	size_t println(const char c[]);
+
+	/** Waits until the last stop bit is sent */
+	void flush();
+
+	int availableForWrite();
+
+	int available(void);
+
+	/** Gets the copy of the statistics */
+	AvrSwUartStats getStats() const;
+
+	void resetStats();
+
+	/** Interrupt handlers, not for the application use */
+	static void onPinChange();
+	static void onRxBit();
+	static void onTxBit();
+protected:
+	AvrSwUartBase(const AvrSwUartConfig &config, uint8_t *rxBuf, uint8_t rxSize, uint8_t *txBuf, uint8_t txSize);
+private:
+	// The rings like `RingBuffer`: free-running indexes, the size is a power of two
+	uint8_t												*const mRxBuf;
+	const uint8_t										mRxMask;
+	volatile uint8_t									mRxHead;
+	volatile uint8_t									mRxTail;
+	uint8_t												*const mTxBuf;
+	const uint8_t										mTxMask;
+	volatile uint8_t									mTxHead;
+	volatile uint8_t									mTxTail;
+	// Pins
+	volatile uint8_t									*mRxPinReg;
+	uint8_t												mRxPinMask;
+	volatile uint8_t									*mTxPortReg;
+	uint8_t												mTxPinMask;
+	volatile uint8_t									*mPcMaskReg;
+	uint8_t												mPcMaskBit;
+	uint8_t												mPcCtrlBit;
+	// Timer1 ticks
+	uint16_t											mBitTicks;
+	uint16_t											mStartTicks;
+	// State
+	volatile uint8_t									mRxBitIdx;
+	uint8_t												mRxByte;
+	volatile uint16_t									mTxFrame;
+	volatile bool										mTxActive;
+	AvrSwUartStats										mStats;
+	unsigned long										mTimeoutMs;
+
+	void startTx();
+
+	AvrSwUartBase(const AvrSwUartBase&);
+	AvrSwUartBase& operator=(const AvrSwUartBase&);
+};
+
+template<uint32_t RX_BUFFER_SIZE = 64, uint32_t TX_BUFFER_SIZE = 16>
+class AvrSwUart: public AvrSwUartBase {
+	static_assert(RX_BUFFER_SIZE && !(RX_BUFFER_SIZE & (RX_BUFFER_SIZE - 1)), "RX size must be a power of two");
+	static_assert(TX_BUFFER_SIZE && !(TX_BUFFER_SIZE & (TX_BUFFER_SIZE - 1)), "TX size must be a power of two");
+	static_assert(RX_BUFFER_SIZE <= 128 && TX_BUFFER_SIZE <= 128, "Size is too big for the index");
+public:
+	AvrSwUart(const AvrSwUartConfig &config)
+		: AvrSwUartBase(config, mRxData, RX_BUFFER_SIZE, mTxData, TX_BUFFER_SIZE) {}
+private:
+	uint8_t												mRxData[RX_BUFFER_SIZE];
+	uint8_t												mTxData[TX_BUFFER_SIZE];
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_AVR_SW_UART_H_
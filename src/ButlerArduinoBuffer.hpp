@@ -18,6 +18,7 @@
 /* System Includes */
 #include <stdint.h>
 /* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
 
 
 namespace Butler {
@@ -31,12 +32,27 @@ struct BufferBase {
 	virtual const TYPE_T* get() const = 0;
 	/** Gets the array size */
 	virtual uint32_t size() const = 0;
+	/** Gets non-owning view of the whole array */
+	BufferViewBase<TYPE_T> view() { return BufferViewBase<TYPE_T>(get(), size()); }
+	BufferViewBase<const TYPE_T> view() const { return BufferViewBase<const TYPE_T>(get(), size()); }
+	operator BufferViewBase<TYPE_T>() { return view(); }
+	operator BufferViewBase<const TYPE_T>() const { return view(); }
 };
 
 struct Buffer: public BufferBase<uint8_t> {
 	virtual ~Buffer() {}
 };
 
+/** Non-owning `Buffer` over the view, passes the view to the `Buffer` API */
+struct ViewBuffer: public Buffer {
+	ViewBuffer(const BufferView &view): mView(view) {}
+	uint8_t* get() { return mView.get(); }
+	const uint8_t* get() const { return mView.get(); }
+	uint32_t size() const { return mView.size(); }
+private:
+	BufferView											mView;
+};
+
 }}
 
 #endif // BUTLER_ARDUINO_BUFFER_H_
@@ -0,0 +1,104 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Buffer chain implementation.
+ *    Scatter-gather list of buffer views.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_BUFFER_CHAIN_H_
+#define BUTLER_ARDUINO_BUFFER_CHAIN_H_
+
+/* System Includes */
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+class BufferChainBase {
+public:
+	/** Appends the view. Returns `false` if the chain is full. */
+	bool add(const ConstBufferView &view) {
+		if (mQty >= mCapacity) {
+			return false;
+		}
+		if (!view.empty()) {
+			mViews[mQty++] = view;
+		}
+		return true;
+	}
+
+	/** Appends all views of another chain. Returns `false` if the chain is full. */
+	bool add(const BufferChainBase &chain) {
+		for (uint8_t i = 0; i < chain.count(); ++i) {
+			if (!add(chain[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void clear() { mQty = 0; }
+
+	/** Gets the views quantity */
+	uint8_t count() const { return mQty; }
+
+	uint8_t capacity() const { return mCapacity; }
+
+	const ConstBufferView& operator[](uint8_t idx) const { return mViews[idx]; }
+
+	/** Gets the total size of all views */
+	uint32_t size() const {
+		uint32_t res = 0;
+		for (uint8_t i = 0; i < mQty; ++i) {
+			res += mViews[i].size();
+		}
+		return res;
+	}
+
+	/** Joins the views to the buffer. Returns the copied bytes quantity. */
+	uint32_t copyTo(const BufferView &buffer) const {
+		uint32_t res = 0;
+		for (uint8_t i = 0; i < mQty && res < buffer.size(); ++i) {
+			ConstBufferView v = mViews[i].slice(0, buffer.size() - res);
+			memcpy(buffer.get() + res, v.get(), v.size());
+			res += v.size();
+		}
+		return res;
+	}
+
+protected:
+	BufferChainBase(ConstBufferView *views, uint8_t capacity)
+		: mViews(views), mCapacity(capacity), mQty(0)
+	{}
+
+private:
+	ConstBufferView										*mViews;
+	uint8_t												mCapacity;
+	uint8_t												mQty;
+
+	BufferChainBase(const BufferChainBase&);
+	BufferChainBase& operator=(const BufferChainBase&);
+};
+
+template<uint8_t CHAIN_SIZE = 4>
+class BufferChain: public BufferChainBase {
+public:
+	BufferChain(): BufferChainBase(mStorage, CHAIN_SIZE) {}
+private:
+	ConstBufferView										mStorage[CHAIN_SIZE];
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_BUFFER_CHAIN_H_
@@ -0,0 +1,72 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Buffer view implementation.
+ *    Non-owning pointer and length pair.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_BUFFER_VIEW_H_
+#define BUTLER_ARDUINO_BUFFER_VIEW_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+/* Internal Includes */
+
+
+namespace Butler {
+namespace Arduino {
+
+template<typename TYPE_T>
+class BufferViewBase {
+public:
+	BufferViewBase(): mBuf(NULL), mSize(0) {}
+
+	BufferViewBase(TYPE_T *buf, uint32_t size): mBuf(buf), mSize(size) {}
+
+	/** Converts the mutable view to the constant one */
+	template<typename OTHER_T>
+	BufferViewBase(const BufferViewBase<OTHER_T> &o): mBuf(o.get()), mSize(o.size()) {}
+
+	/** Gets pointer to array */
+	TYPE_T* get() const { return mBuf; }
+
+	/** Gets the array size */
+	uint32_t size() const { return mSize; }
+
+	bool empty() const { return !mSize; }
+
+	/**
+	 * Gets the view of sub-range.
+	 * The sub-range is truncated to fit the view.
+	 */
+	BufferViewBase slice(uint32_t offset, uint32_t length = 0xFFFFFFFFUL) const {
+		if (offset > mSize) {
+			offset = mSize;
+		}
+		if (length > mSize - offset) {
+			length = mSize - offset;
+		}
+		return BufferViewBase(mBuf + offset, length);
+	}
+
+private:
+	TYPE_T												*mBuf;
+	uint32_t											mSize;
+};
+
+typedef BufferViewBase<uint8_t>							BufferView;
+typedef BufferViewBase<const uint8_t>					ConstBufferView;
+typedef BufferViewBase<char>							CharBufferView;
+typedef BufferViewBase<const char>						ConstCharBufferView;
+
+}}
+
+#endif // BUTLER_ARDUINO_BUFFER_VIEW_H_
@@ -0,0 +1,200 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Byte writer implementation.
+ *    Growable heap buffer with separate size and capacity.
+ *    Implements the Arduino Print to be used as the JSON `printTo` target.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_BYTE_WRITER_H_
+#define BUTLER_ARDUINO_BYTE_WRITER_H_
+
+/* System Includes */
+#include <Arduino.h>
+#include <Print.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
+
+
+#ifndef BUTLER_ARDUINO_BYTE_WRITER_CAPACITY_MIN
+	#define BUTLER_ARDUINO_BYTE_WRITER_CAPACITY_MIN		16
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * The capacity grows geometrically and is never released on shrink
+ * or `clear`, so the writer reused across the calls stops allocating.
+ * Allocation failure is reported by the returned bytes quantity
+ * like the Arduino Print does.
+ */
+class ByteWriter: public ::Print {
+public:
+	ByteWriter(): mBuf(NULL), mSize(0), mCapacity(0) {}
+
+	explicit ByteWriter(uint32_t capacity): mBuf(NULL), mSize(0), mCapacity(0) {
+		reserve(capacity);
+	}
+
+	ByteWriter(ByteWriter &&o): mBuf(o.mBuf), mSize(o.mSize), mCapacity(o.mCapacity) {
+		o.mBuf = NULL;
+		o.mSize = o.mCapacity = 0;
+	}
+
+	~ByteWriter() { delete[] mBuf; }
+
+	ByteWriter& operator=(ByteWriter &&o) {
+		if (this != &o) {
+			delete[] mBuf;
+			mBuf = o.mBuf;
+			mSize = o.mSize;
+			mCapacity = o.mCapacity;
+			o.mBuf = NULL;
+			o.mSize = o.mCapacity = 0;
+		}
+		return *this;
+	}
+
+	uint8_t* get() { return mBuf; }
+	const uint8_t* get() const { return mBuf; }
+
+	/** Gets the written bytes quantity */
+	uint32_t size() const { return mSize; }
+
+	/** Gets the allocated bytes quantity */
+	uint32_t capacity() const { return mCapacity; }
+
+	bool empty() const { return !mSize; }
+
+	/** Gets non-owning view of the written bytes */
+	BufferView view() { return BufferView(mBuf, mSize); }
+	ConstBufferView view() const { return ConstBufferView(mBuf, mSize); }
+	operator BufferView() { return view(); }
+	operator ConstBufferView() const { return view(); }
+
+	/** Drops the content, keeps the capacity */
+	void clear() { mSize = 0; }
+
+	/**
+	 * Ensures the capacity, keeps the content.
+	 * Returns `false` if the allocation fails.
+	 */
+	bool reserve(uint32_t capacity) {
+		if (capacity <= mCapacity) {
+			return true;
+		}
+		uint8_t *buf = new uint8_t[capacity];
+		if (!buf) {
+			return false;
+		}
+		if (mSize) {
+			memcpy(buf, mBuf, mSize);
+		}
+		delete[] mBuf;
+		mBuf = buf;
+		mCapacity = capacity;
+		return true;
+	}
+
+	/**
+	 * Changes the size. Shrinking is done in place.
+	 * Returns `false` if the allocation fails.
+	 */
+	bool resize(uint32_t size) {
+		if (!grow(size)) {
+			return false;
+		}
+		mSize = size;
+		return true;
+	}
+
+	/** Appends the bytes. Returns the appended bytes quantity. */
+	size_t append(const void *data, uint32_t size) {
+		if (!grow(mSize + size)) {
+			return 0;
+		}
+		memcpy(mBuf + mSize, data, size);
+		mSize += size;
+		return size;
+	}
+
+	size_t append(const ConstBufferView &data) { return append(data.get(), data.size()); }
+
+	size_t append(const char *str) { return append(str, strlen(str)); }
+
+	/** Appends the formatted string without the terminating null */
+	size_t printf(const char *fmt, ...) __attribute__ ((format (printf, 2, 3))) {
+		va_list ap;
+		va_start(ap, fmt);
+		size_t res = vprintf(fmt, ap);
+		va_end(ap);
+		return res;
+	}
+
+	size_t vprintf(const char *fmt, va_list ap) {
+		// Try to fit into the free space first
+		va_list apCopy;
+		va_copy(apCopy, ap);
+		int qty = ::vsnprintf(reinterpret_cast<char*>(mBuf + mSize), mCapacity - mSize, fmt, apCopy);
+		va_end(apCopy);
+		if (qty < 0) {
+			return 0;
+		}
+		if (mSize + static_cast<uint32_t>(qty) >= mCapacity) {
+			if (!grow(mSize + qty + 1)) {
+				return 0;
+			}
+			::vsnprintf(reinterpret_cast<char*>(mBuf + mSize), mCapacity - mSize, fmt, ap);
+		}
+		mSize += qty;
+		return qty;
+	}
+
+	size_t write(uint8_t v) {
+		if (!grow(mSize + 1)) {
+			return 0;
+		}
+		mBuf[mSize++] = v;
+		return 1;
+	}
+
+	size_t write(const uint8_t *buffer, size_t size) { return append(buffer, size); }
+
+	using ::Print::write;
+
+private:
+	uint8_t												*mBuf;
+	uint32_t											mSize;
+	uint32_t											mCapacity;
+
+	/** Ensures the capacity using the geometric growth */
+	bool grow(uint32_t size) {
+		if (size <= mCapacity) {
+			return true;
+		}
+		uint32_t capacity = mCapacity ? mCapacity : BUTLER_ARDUINO_BYTE_WRITER_CAPACITY_MIN;
+		while (capacity < size) {
+			capacity *= 2;
+		}
+		return reserve(capacity);
+	}
+
+	ByteWriter(const ByteWriter&);
+	ByteWriter& operator=(const ByteWriter&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_BYTE_WRITER_H_
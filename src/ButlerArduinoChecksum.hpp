@@ -0,0 +1,261 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Checksum implementation.
+ *    CRC family with the lookup tables generated at compile time
+ *    and the Fletcher-32.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_CHECKSUM_H_
+#define BUTLER_ARDUINO_CHECKSUM_H_
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdint.h>
+/* Internal Includes */
+#include "ButlerArduinoCrc.h"
+
+
+#ifdef __AVR__
+	// The tables are in flash, the RAM is too small
+	#define BUTLER_ARDUINO_CHECKSUM_TABLE_ATTR			PROGMEM
+#else
+	#define BUTLER_ARDUINO_CHECKSUM_TABLE_ATTR
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * CRC parameters in terms of the Rocksoft model.
+ * The width is the size of VALUE_T, `refin` and `refout` are equal.
+ */
+template<typename VALUE_T, VALUE_T POLY, VALUE_T INIT, bool REFLECTED, VALUE_T XOR_OUT>
+struct CrcParams {
+	typedef VALUE_T										Value;
+	static const VALUE_T								poly = POLY;
+	static const VALUE_T								init = INIT;
+	static const bool									reflected = REFLECTED;
+	static const VALUE_T								xorOut = XOR_OUT;
+};
+
+/** CRC-8 (SMBus): check("123456789") = 0xF4 */
+typedef CrcParams<uint8_t, 0x07, 0x00, false, 0x00>				Crc8Params;
+/** CRC-16/CCITT-FALSE: check("123456789") = 0x29B1 */
+typedef CrcParams<uint16_t, 0x1021, 0xFFFF, false, 0x0000>		Crc16CcittParams;
+/** CRC-32/IEEE: check("123456789") = 0xCBF43926 */
+typedef CrcParams<uint32_t, 0x04C11DB7UL, 0xFFFFFFFFUL, true, 0xFFFFFFFFUL>	Crc32Params;
+/** Fletcher-32 over the little-endian 16-bit words, the odd byte is padded by zero */
+struct Fletcher32Params {};
+
+namespace ChecksumPrivate {
+
+template<uint16_t... I>
+struct Indices {};
+
+template<uint16_t N, uint16_t... I>
+struct MakeIndices: MakeIndices<N - 1, N - 1, I...> {};
+
+template<uint16_t... I>
+struct MakeIndices<0, I...> {
+	typedef Indices<I...>								Type;
+};
+
+template<typename VALUE_T>
+constexpr VALUE_T reflect(VALUE_T v, uint8_t bits, VALUE_T r = 0) {
+	return bits ? reflect<VALUE_T>(v >> 1, bits - 1, (r << 1) | (v & 1)) : r;
+}
+
+template<class PARAMS_T>
+struct CrcTableEntry {
+	typedef typename PARAMS_T::Value					Value;
+	static const uint8_t								WIDTH = sizeof(Value) * 8;
+	static const Value									TOP_BIT = static_cast<Value>(1) << (WIDTH - 1);
+
+	static constexpr Value reflectedStep(Value c, uint8_t k) {
+		return k ? reflectedStep((c & 1) ? static_cast<Value>((c >> 1) ^ reflect<Value>(PARAMS_T::poly, WIDTH))
+			: static_cast<Value>(c >> 1), k - 1) : c;
+	}
+
+	static constexpr Value normalStep(Value c, uint8_t k) {
+		return k ? normalStep((c & TOP_BIT) ? static_cast<Value>((c << 1) ^ PARAMS_T::poly)
+			: static_cast<Value>(c << 1), k - 1) : c;
+	}
+
+	static constexpr Value value(uint16_t i) {
+		return PARAMS_T::reflected ? reflectedStep(static_cast<Value>(i), 8)
+			: normalStep(static_cast<Value>(static_cast<Value>(i) << (WIDTH - 8)), 8);
+	}
+};
+
+template<class PARAMS_T, class INDICES_T = typename MakeIndices<256>::Type>
+struct CrcTable;
+
+template<class PARAMS_T, uint16_t... I>
+struct CrcTable<PARAMS_T, Indices<I...> > {
+	static const typename PARAMS_T::Value				data[256];
+};
+
+template<class PARAMS_T, uint16_t... I>
+const typename PARAMS_T::Value CrcTable<PARAMS_T, Indices<I...> >::data[256] BUTLER_ARDUINO_CHECKSUM_TABLE_ATTR = {
+	CrcTableEntry<PARAMS_T>::value(I)...
+};
+
+#ifdef __AVR__
+inline uint8_t tableRead(const uint8_t *p) { return pgm_read_byte(p); }
+inline uint16_t tableRead(const uint16_t *p) { return pgm_read_word(p); }
+inline uint32_t tableRead(const uint32_t *p) { return pgm_read_dword(p); }
+#else
+template<typename VALUE_T>
+inline VALUE_T tableRead(const VALUE_T *p) { return *p; }
+#endif
+
+} // ChecksumPrivate
+
+/**
+ * Streaming checksum with the `crc32Begin/Continue/End` like API:
+ *
+ *     Checksum<Crc16CcittParams>::State s = Checksum<Crc16CcittParams>::begin();
+ *     s = Checksum<Crc16CcittParams>::update(s, b, len);
+ *     uint16_t crc = Checksum<Crc16CcittParams>::end(s);
+ *
+ * The generic version is the byte-wise table CRC, the table is generated
+ * at compile time and instantiated only if used (256 entries of the CRC width).
+ */
+template<class PARAMS_T>
+class Checksum {
+public:
+	typedef typename PARAMS_T::Value					Value;
+	typedef Value										State;
+
+	static State begin() {
+		return PARAMS_T::reflected ? ChecksumPrivate::reflect<Value>(PARAMS_T::init, WIDTH) : PARAMS_T::init;
+	}
+
+	static State update(State s, const uint8_t b[], uint32_t len) {
+		const Value *table = ChecksumPrivate::CrcTable<PARAMS_T>::data;
+		if (PARAMS_T::reflected) {
+			for (uint32_t i = 0; i < len; i++) {
+				s = ChecksumPrivate::tableRead(table + static_cast<uint8_t>(s ^ b[i])) ^ static_cast<Value>(s >> 8);
+			}
+		} else {
+			for (uint32_t i = 0; i < len; i++) {
+				s = ChecksumPrivate::tableRead(table + static_cast<uint8_t>((s >> (WIDTH - 8)) ^ b[i]))
+					^ static_cast<Value>(s << 8);
+			}
+		}
+		return s;
+	}
+
+	static Value end(State s) {
+		return s ^ PARAMS_T::xorOut;
+	}
+
+	static Value calc(const uint8_t b[], uint32_t len) {
+		return end(update(begin(), b, len));
+	}
+
+private:
+	static const uint8_t								WIDTH = sizeof(Value) * 8;
+};
+
+/** CRC-32 uses the tuned engines of `Crc` */
+template<>
+class Checksum<Crc32Params> {
+public:
+	typedef uint32_t									Value;
+	typedef uint32_t									State;
+
+	static State begin() { return Crc::crc32Begin(); }
+
+	static State update(State s, const uint8_t b[], uint32_t len) { return Crc::crc32Continue(s, b, len); }
+
+	static Value end(State s) { return Crc::crc32End(s); }
+
+	static Value calc(const uint8_t b[], uint32_t len) { return Crc::crc32(b, len); }
+};
+
+/** Fletcher-32, no table. Sums are reduced once per 359 words, the maximum without overflow. */
+template<>
+class Checksum<Fletcher32Params> {
+public:
+	typedef uint32_t									Value;
+
+	struct State {
+		uint32_t										sum1;
+		uint32_t										sum2;
+		int16_t											odd; // pending low byte of the word or -1
+	};
+
+	static State begin() {
+		State s = {0xFFFF, 0xFFFF, -1};
+		return s;
+	}
+
+	static State update(State s, const uint8_t b[], uint32_t len) {
+		if (len && s.odd >= 0) {
+			add(s, static_cast<uint16_t>(s.odd | (static_cast<uint16_t>(b[0]) << 8)));
+			reduce(s);
+			s.odd = -1;
+			b++;
+			len--;
+		}
+		while (len >= 2) {
+			uint32_t words = len / 2;
+			if (words > WORDS_PER_REDUCTION) {
+				words = WORDS_PER_REDUCTION;
+			}
+			len -= words * 2;
+			for (; words; words--, b += 2) {
+				add(s, static_cast<uint16_t>(b[0] | (static_cast<uint16_t>(b[1]) << 8)));
+			}
+			reduce(s);
+		}
+		if (len) {
+			s.odd = b[0];
+		}
+		return s;
+	}
+
+	static Value end(State s) {
+		if (s.odd >= 0) {
+			add(s, static_cast<uint16_t>(s.odd));
+		}
+		reduce(s);
+		reduce(s);
+		return (s.sum2 << 16) | s.sum1;
+	}
+
+	static Value calc(const uint8_t b[], uint32_t len) {
+		return end(update(begin(), b, len));
+	}
+
+private:
+	static const uint32_t								WORDS_PER_REDUCTION = 359;
+
+	static void add(State &s, uint16_t word) {
+		s.sum1 += word;
+		s.sum2 += s.sum1;
+	}
+
+	static void reduce(State &s) {
+		s.sum1 = (s.sum1 & 0xFFFF) + (s.sum1 >> 16);
+		s.sum2 = (s.sum2 & 0xFFFF) + (s.sum2 >> 16);
+	}
+};
+
+typedef Checksum<Crc8Params>							Crc8;
+typedef Checksum<Crc16CcittParams>						Crc16Ccitt;
+typedef Checksum<Crc32Params>							Crc32;
+typedef Checksum<Fletcher32Params>						Fletcher32;
+
+}}
+
+#endif // BUTLER_ARDUINO_CHECKSUM_H_
@@ -26,11 +26,13 @@ namespace Arduino {
 namespace Time {class Clock;}
 class Print;
 class Lpm;
+class Arena;
 
 struct Context {
 	Time::Clock											*time = NULL;
 	Print												*logger = NULL;
 	Lpm													*lpm = NULL;
+	Arena												*arena = NULL;
 };
 
 }}
@@ -15,10 +15,67 @@
 #define BUTLER_ARDUINO_CRC_H_
 
 /* System Includes */
+#include <stddef.h>
 #include <stdint.h>
 /* Internal Includes */
 
 
+/**
+ * CRC32 engines:
+ *   - NIBBLE: 16 entries table, two lookups per byte, 64 bytes
+ *   - BYTE: 256 entries table, one lookup per byte, 1 KB
+ *   - SLICING_8: 8 x 256 entries table, eight bytes per step, 8 KB
+ *   - CLMUL: x86-64 host only, PCLMULQDQ folding, SLICING_8 if the CPU has no PCLMULQDQ
+ */
+#define BUTLER_ARDUINO_CRC32_ENGINE_NIBBLE				1
+#define BUTLER_ARDUINO_CRC32_ENGINE_BYTE				2
+#define BUTLER_ARDUINO_CRC32_ENGINE_SLICING_8			3
+#define BUTLER_ARDUINO_CRC32_ENGINE_CLMUL				4
+
+#if defined(__x86_64__) && defined(__GNUC__)
+	#define BUTLER_ARDUINO_CRC32_CLMUL_SUPPORTED		1
+#else
+	#define BUTLER_ARDUINO_CRC32_CLMUL_SUPPORTED		0
+#endif
+
+#ifndef BUTLER_ARDUINO_CRC32_ENGINE
+	#ifdef __AVR__
+		#define BUTLER_ARDUINO_CRC32_ENGINE				BUTLER_ARDUINO_CRC32_ENGINE_NIBBLE
+	#elif BUTLER_ARDUINO_CRC32_CLMUL_SUPPORTED
+		#define BUTLER_ARDUINO_CRC32_ENGINE				BUTLER_ARDUINO_CRC32_ENGINE_CLMUL
+	#else
+		#define BUTLER_ARDUINO_CRC32_ENGINE				BUTLER_ARDUINO_CRC32_ENGINE_BYTE
+	#endif
+#endif
+
+/**
+ * CRC32 table placement:
+ *   - PROGMEM: flash, read by `pgm_read_dword`
+ *   - DRAM: data RAM
+ *   - IRAM: instruction RAM on ESP8266 (32-bit reads only), DRAM on other platforms
+ */
+#define BUTLER_ARDUINO_CRC32_TABLE_PROGMEM				1
+#define BUTLER_ARDUINO_CRC32_TABLE_DRAM					2
+#define BUTLER_ARDUINO_CRC32_TABLE_IRAM					3
+
+#ifndef BUTLER_ARDUINO_CRC32_TABLE
+	#ifdef ESP8266
+		#define BUTLER_ARDUINO_CRC32_TABLE				BUTLER_ARDUINO_CRC32_TABLE_DRAM
+	#else
+		#define BUTLER_ARDUINO_CRC32_TABLE				BUTLER_ARDUINO_CRC32_TABLE_PROGMEM
+	#endif
+#endif
+
+/** Builds all engines to compare them, see `crc32ContinueNibble` and others */
+#ifndef BUTLER_ARDUINO_CRC32_ENGINES_ALL
+	#define BUTLER_ARDUINO_CRC32_ENGINES_ALL			0
+#endif
+
+/** Host only: builds `crc32Bulk`, requires the threads support */
+#ifndef BUTLER_ARDUINO_CRC32_BULK
+	#define BUTLER_ARDUINO_CRC32_BULK					0
+#endif
+
 namespace Butler {
 namespace Arduino {
 
@@ -34,6 +91,32 @@ uint32_t crc32(const char *s);
 
 uint32_t crc32(const uint8_t b[], uint32_t len);
 
+#if BUTLER_ARDUINO_CRC32_ENGINES_ALL
+uint32_t crc32ContinueNibble(uint32_t crc, const uint8_t b[], uint32_t len);
+
+uint32_t crc32ContinueByte(uint32_t crc, const uint8_t b[], uint32_t len);
+
+uint32_t crc32ContinueSlicing8(uint32_t crc, const uint8_t b[], uint32_t len);
+
+#if BUTLER_ARDUINO_CRC32_CLMUL_SUPPORTED
+uint32_t crc32ContinueClmul(uint32_t crc, const uint8_t b[], uint32_t len);
+#endif
+#endif
+
+#if BUTLER_ARDUINO_CRC32_BULK
+struct Crc32Job {
+	const uint8_t										*data;
+	size_t												len;
+	uint32_t											crc; // result
+};
+
+/**
+ * Calculates the CRC32 of every job buffer.
+ * The jobs are shared by the threads, `0` threads means one per CPU.
+ */
+void crc32Bulk(Crc32Job jobs[], size_t qty, unsigned threadsQty = 0);
+#endif
+
 } // Crc
 
 }}
@@ -0,0 +1,199 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: ESP crash log implementation.
+ *    Keeps the last log records in the RTC user memory to survive the crash.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_ESP_CRASH_LOG_H_
+#define BUTLER_ARDUINO_ESP_CRASH_LOG_H_
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoPrint.hpp"
+#include "ButlerArduinoCrc.h"
+#include "ButlerArduinoBufferView.hpp"
+
+
+/** RTC user memory bytes taken from the tail, zero disables the crash log */
+#ifndef BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+	#define BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE				0
+#endif
+
+/** Longer text lines are truncated */
+#ifndef BUTLER_ARDUINO_ESP_CRASH_LOG_LINE_MAX
+	#define BUTLER_ARDUINO_ESP_CRASH_LOG_LINE_MAX			48
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * Passes everything to the next `Print` and keeps the tail of the log
+ * in the CRC protected ring at the end of the RTC user memory.
+ * The `println` lines are truncated, the written bytes (the `Logger` lines
+ * and the binary records) are kept as is, so the `LogDecoder` can restore them.
+ * The ring survives the deep sleep and the reset but not the power loss.
+ * `begin` freezes the ring if the board is restarted by an exception
+ * or a watchdog, the post-mortem is kept until `clear`.
+ */
+class EspCrashLog: public Print {
+public:
+	/** The ESP8266 has 512 bytes of the RTC user memory */
+	static const uint32_t								RTC_USER_MEMORY_SIZE = 512;
+	static const uint32_t								RTC_SIZE = BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE;
+
+	using Print::write;
+
+	EspCrashLog(Print &out): mOut(out) {
+		memset(&mRing, 0, sizeof(mRing));
+	}
+
+	/** Restores the ring, must be called once on board start */
+	void begin() {
+		if (!RTC_SIZE) {
+			return;
+		}
+		ESP.rtcUserMemoryRead(RTC_OFFSET_BLOCKS, reinterpret_cast<uint32_t*>(&mRing), sizeof(mRing));
+		if (mRing.header.crc != calcCrc() || mRing.header.head >= DATA_SIZE || mRing.header.qty > DATA_SIZE) {
+			memset(&mRing, 0, sizeof(mRing));
+		}
+		if (!mRing.header.crashed && mRing.header.qty && isCrash(ESP.getResetInfoPtr()->reason)) {
+			mRing.header.crashed = true;
+			mRing.header.reason = ESP.getResetInfoPtr()->reason;
+		}
+		store();
+	}
+
+	size_t println(const char *v) {
+		if (!mRing.header.crashed) {
+			const size_t size = strlen(v);
+			push(reinterpret_cast<const uint8_t*>(v), size < LINE_MAX ? size : LINE_MAX);
+			push(reinterpret_cast<const uint8_t*>("\n"), 1);
+			store();
+		}
+		return mOut.println(v);
+	}
+
+	size_t write(const uint8_t buffer[], size_t size) {
+		if (!mRing.header.crashed) {
+			push(buffer, size);
+			store();
+		}
+		return mOut.write(buffer, size);
+	}
+
+	void flush() {
+		mOut.flush();
+	}
+
+	/** Checks if the ring keeps the log of the crashed run */
+	bool isCrashed() const {
+		return mRing.header.crashed;
+	}
+
+	/** Gets the reset reason of the crash, see `rst_reason` */
+	uint8_t getReason() const {
+		return mRing.header.reason;
+	}
+
+	/** Gets the stored bytes quantity */
+	uint32_t size() const {
+		return mRing.header.qty;
+	}
+
+	/** Copies the stored bytes from the oldest one, returns the copied quantity */
+	uint32_t read(const BufferView &out) const {
+		const uint32_t qty = out.size() < mRing.header.qty ? out.size() : mRing.header.qty;
+		uint32_t idx = (mRing.header.head + DATA_SIZE - mRing.header.qty) % DATA_SIZE;
+		for (uint32_t i = 0; i < qty; i++) {
+			out.get()[i] = mRing.data[idx];
+			idx = (idx + 1) % DATA_SIZE;
+		}
+		return qty;
+	}
+
+	/** Forgets the stored bytes and continues the recording */
+	void clear() {
+		memset(&mRing, 0, sizeof(mRing));
+		store();
+	}
+
+private:
+	static const uint32_t								LINE_MAX = BUTLER_ARDUINO_ESP_CRASH_LOG_LINE_MAX;
+
+	struct Header {
+		uint32_t										crc;
+		uint16_t										head;
+		uint16_t										qty;
+		uint8_t											crashed;
+		uint8_t											reason;
+		uint8_t											reserved[2];
+	} __attribute__((aligned(4)));
+
+	// Keeps the class valid when the crash log is disabled
+	static const uint32_t								DATA_SIZE = RTC_SIZE > sizeof(Header) ? RTC_SIZE - sizeof(Header) : 4;
+	static const uint32_t								RTC_OFFSET_BLOCKS = (RTC_USER_MEMORY_SIZE - sizeof(Header) - DATA_SIZE) / 4;
+
+	static_assert(RTC_SIZE % 4 == 0, "The RTC memory is accessed by 4 bytes blocks");
+	static_assert(RTC_SIZE == 0 || RTC_SIZE > sizeof(Header), "Too small crash log");
+	static_assert(RTC_SIZE <= RTC_USER_MEMORY_SIZE / 2, "Too big crash log");
+
+	struct Ring {
+		Header											header;
+		uint8_t											data[DATA_SIZE];
+	} __attribute__((aligned(4)));
+
+	Print												&mOut;
+	Ring												mRing;
+
+	static bool isCrash(uint32_t reason) {
+		return reason == REASON_WDT_RST || reason == REASON_EXCEPTION_RST || reason == REASON_SOFT_WDT_RST;
+	}
+
+	uint32_t calcCrc() const {
+		uint32_t crc = Crc::crc32Begin();
+		crc = Crc::crc32Continue(crc, reinterpret_cast<const uint8_t*>(&mRing.header.head),
+			sizeof(mRing.header) - sizeof(mRing.header.crc)
+		);
+		crc = Crc::crc32Continue(crc, mRing.data, sizeof(mRing.data));
+		return Crc::crc32End(crc);
+	}
+
+	void push(const uint8_t *data, size_t size) {
+		if (size > DATA_SIZE) {
+			// Only the tail fits
+			data += size - DATA_SIZE;
+			size = DATA_SIZE;
+		}
+		for (size_t i = 0; i < size; i++) {
+			mRing.data[mRing.header.head] = data[i];
+			mRing.header.head = (mRing.header.head + 1) % DATA_SIZE;
+		}
+		mRing.header.qty = (mRing.header.qty + size) < DATA_SIZE ? (mRing.header.qty + size) : DATA_SIZE;
+	}
+
+	void store() {
+		if (RTC_SIZE) {
+			mRing.header.crc = calcCrc();
+			ESP.rtcUserMemoryWrite(RTC_OFFSET_BLOCKS, reinterpret_cast<uint32_t*>(&mRing), sizeof(mRing));
+		}
+	}
+
+	EspCrashLog(const EspCrashLog&);
+	EspCrashLog& operator=(const EspCrashLog&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_ESP_CRASH_LOG_H_
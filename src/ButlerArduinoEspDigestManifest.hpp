@@ -0,0 +1,154 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: ESP file digest manifest implementation.
+ *    Keeps MD5 of the downloaded files to avoid the recalculation.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_H_
+#define BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_H_
+
+/* System Includes */
+#include <stdint.h>
+#include <string.h>
+#include <WString.h>
+#include <FS.h>
+/* Internal Includes */
+#include "ButlerArduinoStrings.hpp"
+#include "ButlerArduinoCrc.h"
+
+
+#ifndef BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_RECORDS_QTY
+	#define BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_RECORDS_QTY	4
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * The manifest file keeps `{name, size, generation, md5}` records.
+ * The record is valid while the file size is the same, SPIFFS has no
+ * modification time, so only the `updateFile` must change the files.
+ * The generation grows on every record update, the oldest record
+ * is replaced when the manifest is full.
+ */
+class EspDigestManifest {
+public:
+	/** Gets the file MD5 from the manifest, empty string if unknown */
+	String md5(const String &name, uint32_t size) {
+		Manifest m;
+		load(m);
+		int8_t idx = find(m, name);
+		if (idx >= 0 && m.records[idx].size == size) {
+			return String(m.records[idx].md5);
+		}
+		return String();
+	}
+
+	/** Stores the file MD5 */
+	bool update(const String &name, uint32_t size, const String &md5) {
+		if (name.length() >= NAME_SIZE || md5.length() >= MD5_SIZE) {
+			return false;
+		}
+		Manifest m;
+		load(m);
+		int8_t idx = find(m, name);
+		uint32_t generation = 0;
+		for (uint8_t i = 0; i < RECORDS_QTY; i++) {
+			if (m.records[i].generation > generation) {
+				generation = m.records[i].generation;
+			}
+		}
+		if (idx < 0) {
+			// Free record has zero generation, otherwise the oldest
+			idx = 0;
+			for (uint8_t i = 1; i < RECORDS_QTY; i++) {
+				if (m.records[i].generation < m.records[idx].generation) {
+					idx = i;
+				}
+			}
+		}
+		Record &r = m.records[idx];
+		memset(&r, 0, sizeof(r));
+		strncpy(r.name, name.c_str(), NAME_SIZE - 1);
+		strncpy(r.md5, md5.c_str(), MD5_SIZE - 1);
+		r.size = size;
+		r.generation = generation + 1;
+		return save(m);
+	}
+
+	/** Forgets the file */
+	void remove(const String &name) {
+		Manifest m;
+		load(m);
+		int8_t idx = find(m, name);
+		if (idx >= 0) {
+			memset(&m.records[idx], 0, sizeof(Record));
+			save(m);
+		}
+	}
+
+private:
+	static const uint8_t								RECORDS_QTY = BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_RECORDS_QTY;
+	static const uint8_t								NAME_SIZE = 32; // SPIFFS_OBJ_NAME_LEN
+	static const uint8_t								MD5_SIZE = 33;  // HEX + '\0'
+
+	struct Record {
+		char											name[NAME_SIZE];
+		char											md5[MD5_SIZE];
+		uint32_t										size;
+		uint32_t										generation;
+	};
+
+	struct Manifest {
+		Record											records[RECORDS_QTY];
+		uint32_t										crc;
+	};
+
+	static uint32_t calcCrc(const Manifest &m) {
+		return Crc::crc32(reinterpret_cast<const uint8_t*>(m.records), sizeof(m.records));
+	}
+
+	static int8_t find(const Manifest &m, const String &name) {
+		for (uint8_t i = 0; i < RECORDS_QTY; i++) {
+			if (m.records[i].name[0] && name == m.records[i].name) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	static void load(Manifest &m) {
+		bool ok = false;
+		File f = SPIFFS.open(Strings::RamString<>(Strings::FILE_NAME_DIGEST_MANIFEST), "r");
+		if (f) {
+			ok = f.read(reinterpret_cast<uint8_t*>(&m), sizeof(m)) == sizeof(m) && m.crc == calcCrc(m);
+			f.close();
+		}
+		if (!ok) {
+			memset(&m, 0, sizeof(m));
+		}
+	}
+
+	static bool save(Manifest &m) {
+		m.crc = calcCrc(m);
+		File f = SPIFFS.open(Strings::RamString<>(Strings::FILE_NAME_DIGEST_MANIFEST), "w");
+		if (!f) {
+			return false;
+		}
+		bool res = f.write(reinterpret_cast<const uint8_t*>(&m), sizeof(m)) == sizeof(m);
+		f.close();
+		return res;
+	}
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_ESP_DIGEST_MANIFEST_H_
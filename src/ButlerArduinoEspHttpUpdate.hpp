@@ -24,6 +24,7 @@
 #include "ButlerArduinoLogger.hpp"
 #include "ButlerArduinoContext.hpp"
 #include "ButlerArduinoMd5.h"
+#include "ButlerArduinoEspDigestManifest.hpp"
 
 
 namespace Butler {
@@ -39,27 +40,27 @@ public:
 
 	HTTPUpdateResult update(
 		const String &url,
-		const String &httpsFingerprint = Strings::EMPTY,
-		const String &authToken = Strings::EMPTY)
+		const String &httpsFingerprint = String(),
+		const String &authToken = String())
 	{
-		LOG_PRINTFLN(getContext(), "[update-fw] start");
+		LOG_DEBUG(getContext(), UPDATE, "[update-fw] start");
 		HTTPClient http;
 		setupHttpClient(http, url, httpsFingerprint, authToken);
-		HTTPUpdateResult res = handleUpdate(http, Strings::EMPTY, false);
+		HTTPUpdateResult res = handleUpdate(http, String(), false);
 		switch (res) {
 			case HTTP_UPDATE_FAILED:
-				LOG_PRINTFLN(getContext(), "[update-fw] ERROR, Update failed, error: %s",
+				LOG_ERROR(getContext(), UPDATE, "[update-fw] ERROR, Update failed, error: %s",
 						getLastErrorString().c_str()
 				);
 				break;
 			case HTTP_UPDATE_NO_UPDATES:
-				LOG_PRINTFLN(getContext(), "[update-fw] No Updates");
+				LOG_INFO(getContext(), UPDATE, "[update-fw] No Updates");
 				break;
 			case HTTP_UPDATE_OK:
-				LOG_PRINTFLN(getContext(), "[update-fw] OK");
+				LOG_INFO(getContext(), UPDATE, "[update-fw] OK");
 				break;
 			default:
-				LOG_PRINTFLN(getContext(), "[update-fw] ERROR, Update status is UNK, error: %s",
+				LOG_ERROR(getContext(), UPDATE, "[update-fw] ERROR, Update status is UNK, error: %s",
 						getLastErrorString().c_str()
 				);
 				break;
@@ -70,34 +71,44 @@ public:
 	HTTPUpdateResult updateFile(
 		const String &name,
 		const String &url,
-		const String &httpsFingerprint = Strings::EMPTY,
-		const String &authToken = Strings::EMPTY)
+		const String &httpsFingerprint = String(),
+		const String &authToken = String())
 	{
-		LOG_PRINTFLN(getContext(), "[update-file] start, name: %s", name.c_str());
+		LOG_DEBUG(getContext(), UPDATE, "[update-file] start, name: %s", name.c_str());
 		FSInfo fsInfo;
 		String md5;
+		uint32_t size = 0;
+		// SPIFFS takes the names in RAM only
+		const Strings::RamString<> tempName(Strings::FILE_NAME_TEMP_DOWNLOAD);
 		// Cleanup
-		SPIFFS.remove(Strings::FILE_NAME_TEMP_DOWNLOAD);
+		SPIFFS.remove(tempName);
 		// Get FS info
 		if (!SPIFFS.info(fsInfo)) {
-			LOG_PRINTFLN(getContext(), "[update-file] ERROR, Can't get FS info");
+			LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Can't get FS info");
 			return HTTP_UPDATE_FAILED;
 		}
 		// Verify name
 		if (name.length() > fsInfo.maxPathLength) {
-			LOG_PRINTFLN(getContext(), "[update-file] ERROR, Filename is too long");
+			LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Filename is too long");
 			return HTTP_UPDATE_FAILED;
 		}
-		// Calculate file MD5 if available
+		// Get file MD5 if available, calculate only if the manifest has no record
 		if (SPIFFS.exists(name)) {
 			File f = SPIFFS.open(name, "r");
-			md5 = Md5::md5(f);
+			size = f.size();
+			md5 = mManifest.md5(name, size);
+			if (!md5.length()) {
+				md5 = Md5::md5(f);
+				if (md5.length()) {
+					mManifest.update(name, size, md5);
+				}
+			}
 			f.close();
 		}
 		// Open temporary file
-		File f = SPIFFS.open(Strings::FILE_NAME_TEMP_DOWNLOAD, "w+");
+		File f = SPIFFS.open(tempName, "w+");
 		if (!f) {
-			LOG_PRINTFLN(getContext(), "[update-file] ERROR, Can't open temporary file");
+			LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Can't open temporary file");
 			return HTTP_UPDATE_FAILED;
 		}
 		//
@@ -105,62 +116,65 @@ public:
 		// Prepare HTTP request
 		HTTPClient http;
 		setupHttpClient(http, url, httpsFingerprint, authToken);
+		const Strings::RamString<> headerMd5(Strings::HEADER_X_MD5);
 		if (md5.length()) {
-			http.addHeader(Strings::HEADER_X_MD5, md5);
+			http.addHeader(String(headerMd5.c_str()), md5);
 		}
 		// Set headers retrieval list
 		{
-			const char* headers[] = {Strings::HEADER_X_MD5};
+			const char* headers[] = {headerMd5};
 			http.collectHeaders(headers, 1);
 		}
 		// Send HTTP request
 		int32_t httpCode = http.GET();
 		if (httpCode > 0) {
-			LOG_PRINTFLN(getContext(), "[update-file] Update status, code: %i", httpCode);
+			LOG_INFO(getContext(), UPDATE, "[update-file] Update status, code: %i", httpCode);
 			switch(httpCode) {
 				case HTTP_CODE_OK:
 				{
 					// Verify available space
 					int32_t length = http.getSize();
 					if (length > (fsInfo.totalBytes - fsInfo.usedBytes)) {
-						LOG_PRINTFLN(getContext(), "[update-file] ERROR, Not enough space");
+						LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Not enough space");
 						break;
 					}
 					// Get MD5 header value
-					if (http.hasHeader(Strings::HEADER_X_MD5)) {
-						md5 = http.header(Strings::HEADER_X_MD5);
+					if (http.hasHeader(headerMd5)) {
+						md5 = http.header(headerMd5);
 					} else {
-						LOG_PRINTFLN(getContext(), "[update-file] ERROR, Missed MD5 header");
+						LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Missed MD5 header");
 						break;
 					}
-					// Download file
-					http.writeToStream(&f);
+					// Download file, MD5 is calculated on the fly
+					Md5::TeeStream tee(f);
+					http.writeToStream(&tee);
 					http.end();
 					// Verify length
 					if (f.size() != length) {
-						LOG_PRINTFLN(getContext(), "[update-file] ERROR, Incomplete, %lu != %li", f.size(), length);
+						LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Incomplete, %lu != %li", f.size(), length);
 						break;
 					}
 					// Verify MD5
-					if (md5 != Md5::md5(f)) {
-						LOG_PRINTFLN(getContext(), "[update-file] ERROR, MD5 check failed");
+					if (md5 != tee.md5()) {
+						LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, MD5 check failed");
 						break;
 					}
+					size = f.size();
 					res = HTTP_UPDATE_OK;
 				}
 					break;
 				case HTTP_CODE_NOT_MODIFIED:
-					LOG_PRINTFLN(getContext(), "[update-file] No Updates");
+					LOG_INFO(getContext(), UPDATE, "[update-file] No Updates");
 					res = HTTP_UPDATE_NO_UPDATES;
 					break;
 				default:
-					LOG_PRINTFLN(getContext(), "[update-file] ERROR, Update failed, error: %s",
+					LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Update failed, error: %s",
 							http.errorToString(httpCode).c_str()
 					);
 					break;
 			}
 		} else {
-			LOG_PRINTFLN(getContext(), "[update-file] ERROR, Update status is UNK, error: %s",
+			LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Update status is UNK, error: %s",
 					http.errorToString(httpCode).c_str()
 			);
 		}
@@ -172,10 +186,14 @@ public:
 			// Remove current file if exists
 			SPIFFS.remove(name);
 			// Rename temporary file to requested name
-			if (SPIFFS.rename(Strings::FILE_NAME_TEMP_DOWNLOAD, name)) {
-				LOG_PRINTFLN(getContext(), "[update-file] updated");
+			if (SPIFFS.rename(tempName, name)) {
+				LOG_INFO(getContext(), UPDATE, "[update-file] updated");
+				if (!mManifest.update(name, size, md5)) {
+					LOG_WARN(getContext(), UPDATE, "[update-file] WARN, Can't update digest manifest");
+				}
 			} else {
-				LOG_PRINTFLN(getContext(), "[update-file] ERROR, Can't rename temporary file");
+				LOG_ERROR(getContext(), UPDATE, "[update-file] ERROR, Can't rename temporary file");
+				mManifest.remove(name);
 				res = HTTP_UPDATE_FAILED;
 			}
 		}
@@ -184,6 +202,7 @@ public:
 
 private:
 	Context&										mCtx;
+	EspDigestManifest								mManifest;
 
 	Context& getContext() {
 		return mCtx;
@@ -200,11 +219,14 @@ private:
 			http.begin(url, httpsFingerprint);
 			isSecure = true;
 		} else {
-			LOG_PRINTFLN(getContext(), "[update] WARN, Update via HTTP");
+			LOG_WARN(getContext(), UPDATE, "[update] WARN, Update via HTTP");
 			http.begin(url);
 		}
 		if (isSecure && authToken.length()) {
-			http.addHeader(Strings::HEADER_AUTHORIZATION, String(Strings::TOKEN) + Strings::SPACE + authToken);
+			String value(Strings::flash(Strings::TOKEN));
+			value += Strings::flash(Strings::SPACE);
+			value += authToken;
+			http.addHeader(String(Strings::flash(Strings::HEADER_AUTHORIZATION)), value);
 		}
 	}
 };
@@ -22,6 +22,7 @@
 #include "ButlerArduinoCrc.h"
 #include "ButlerArduinoLogger.hpp"
 #include "ButlerArduinoUtil.hpp"
+#include "ButlerArduinoEspCrashLog.hpp"
 
 
 namespace Butler {
@@ -91,13 +92,14 @@ public:
 			}
 		}
 		// Continue
-		LOG_PRINTFLN(getContext(), "[lpm] recovered state: %i", header.ctx.state);
+		LOG_DEBUG(getContext(), LPM, "[lpm] recovered state: %i", header.ctx.state);
 		update(header, data, dataSize, data2, data2Size);
 		return true;
 	}
 
+	/** The tail of the RTC user memory is taken by the `EspCrashLog` */
 	uint32_t getMaxDataSize() const {
-		return 512 - sizeof(LpmControl);
+		return EspCrashLog::RTC_USER_MEMORY_SIZE - sizeof(LpmControl) - EspCrashLog::RTC_SIZE;
 	}
 private:
 	enum LpmState {
@@ -161,7 +163,8 @@ private:
 				// Store state
 				writeHeader(header);
 				// Sleep
-				LOG_PRINTFLN(getContext(), "[lpm] deep sleep for %lu ms", sleepTimeMs);
+				LOG_DEBUG(getContext(), LPM, "[lpm] deep sleep for %lu ms", sleepTimeMs);
+				LOG_FLUSH(getContext());
 				// ! Do not sleep ZERO -> it may sleep forever
 				ESP.deepSleep(max(100UL, sleepTimeMs * 1000UL), rfMode);
 			}
@@ -188,12 +191,13 @@ private:
 		ESP.rtcUserMemoryWrite(0, const_cast<uint32_t*>(reinterpret_cast<const uint32_t*>(&header)), sizeof(LpmControl));
 	}
 
+	// The RTC memory offset is in 4 bytes blocks
 	void readData(uint32_t* data, uint32_t dataSize, uint32_t offset = 0) {
-		ESP.rtcUserMemoryRead(sizeof(LpmControl) + offset, data, dataSize);
+		ESP.rtcUserMemoryRead((sizeof(LpmControl) + offset) / 4, data, dataSize);
 	}
 
 	void writeData(const uint32_t* data, uint32_t dataSize, uint32_t offset = 0) {
-		ESP.rtcUserMemoryWrite(sizeof(LpmControl) + offset, const_cast<uint32_t*>(data), dataSize);
+		ESP.rtcUserMemoryWrite((sizeof(LpmControl) + offset) / 4, const_cast<uint32_t*>(data), dataSize);
 	}
 
 	Context& getContext() {
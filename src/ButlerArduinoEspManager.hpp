@@ -36,11 +36,24 @@ extern "C" {
 #include "ButlerArduinoEspTime.hpp"
 #include "ButlerArduinoUtil.hpp"
 #include "ButlerArduinoHwUart.hpp"
+#include "ButlerArduinoAsyncPrint.hpp"
+#include "ButlerArduinoEspCrashLog.hpp"
+#include "ButlerArduinoMemProfiler.h"
 #include "ButlerArduinoEspWiFiConfigCaptivePortal.hpp"
 #include "ButlerArduinoEspHttpUpdate.hpp"
 #include "ButlerArduinoArrayBuffer.hpp"
+#include "ButlerArduinoArena.hpp"
+#include "ButlerArduinoArenaJsonBuffer.hpp"
 
 
+#ifndef BUTLER_ARDUINO_ESP_MANAGER_ARENA_SIZE
+	#define BUTLER_ARDUINO_ESP_MANAGER_ARENA_SIZE		2048
+#endif
+
+#ifndef BUTLER_ARDUINO_ESP_MANAGER_LOG_BUFFER_SIZE
+	#define BUTLER_ARDUINO_ESP_MANAGER_LOG_BUFFER_SIZE	256
+#endif
+
 namespace Butler {
 namespace Arduino {
 
@@ -69,23 +82,49 @@ class EspManager {
 public:
 	EspManager(uint32_t *lpmData = nullptr, uint32_t lpmDataSize = 0)
 		: mLpm(mCtx), mLpmData(lpmData), mLpmDataSize(lpmDataSize),
-		mHwUart({getConfig().HW_UART_SPEED}), mHttpUpdate(getContext())
+		mHwUart({getConfig().HW_UART_SPEED}), mLogPrint(mHwUart),
+#if BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+		mCrashLog(mLogPrint),
+#endif
+		mHttpUpdate(getContext())
 	{}
 
 	//// ACTIONS ////
 	/** Configures all modules. Must be called ASAP on board start. */
 	void setup() {
+		MEM_PROFILER_BEGIN();
+		MEM_PROFILER_PHASE(SETUP);
 		//// ID ////
-		mId = Util::macAddressToHex(WiFi.macAddress());
+		{
+			uint8_t mac[6];
+			char id[Util::MAC_ADDRESS_HEX_SIZE];
+			mId = Util::macAddressToHex(WiFi.macAddress(mac), id);
+		}
 		//// NAME ////
 		mName = String(getConfig().NAME_PREFIX) + String(ESP.getChipId(), HEX);
 		//// TIME ////
 		mCtx.time = &getClock();
 		//// LOG ////
-		mCtx.logger = &getHwUart();
-		LOG_PRINTFLN(getContext(), "%s", Strings::EMPTY);
+#if BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+		mCrashLog.begin();
+		mCtx.logger = &mCrashLog;
+#else
+		mCtx.logger = &mLogPrint;
+#endif
+		LOG_INFO(getContext(), MANAGER, "%s", "");
+#if BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+		if (mCrashLog.isCrashed()) {
+			LOG_WARN(getContext(), MANAGER, "[manager] WARN, Crash log: %lu B, reason: %u",
+				mCrashLog.size(), mCrashLog.getReason()
+			);
+		}
+#endif
 		//// LPM ////
 		mCtx.lpm = &mLpm;
+		//// ARENA ////
+		if (mArena.begin(BUTLER_ARDUINO_ESP_MANAGER_ARENA_SIZE)) {
+			mCtx.arena = &mArena;
+		}
 		//// FS ////
 		SPIFFS.begin();
 		//// CONFIGURATION ////
@@ -115,19 +154,22 @@ public:
 
 	/** Prints board current state like: heap, time, etc... */
 	void printState() {
-		LOG_PRINTFLN(getContext(), "#################################");
-		LOG_PRINTFLN(getContext(), "###      State");
-		LOG_PRINTFLN(getContext(), "### Heap Free   : %lu B", ESP.getFreeHeap());
-		LOG_PRINTFLN(getContext(), "### Stack Free   : %li B", cont_get_free_stack(&g_cont));
-		LOG_PRINTFLN(getContext(), "### Time        : %lu Ms", getClock().millis());
-		LOG_PRINTFLN(getContext(), "#################################");
+		LOG_INFO(getContext(), MANAGER, "#################################");
+		LOG_INFO(getContext(), MANAGER, "###      State");
+		LOG_INFO(getContext(), MANAGER, "### Heap Free   : %lu B", ESP.getFreeHeap());
+		LOG_INFO(getContext(), MANAGER, "### Stack Free   : %li B", cont_get_free_stack(&g_cont));
+		LOG_INFO(getContext(), MANAGER, "### Arena Peak  : %lu/%lu B", mArena.peak(), mArena.size());
+		LOG_INFO(getContext(), MANAGER, "### Time        : %lu Ms", getClock().millis());
+		LOG_INFO(getContext(), MANAGER, "#################################");
+		MEM_PROFILER_LOG(getContext());
 	}
 
 	/** Puts board to sleep. */
 	void idle(uint32_t ms, bool debug = true) {
 		if (debug) {
-			LOG_PRINTFLN(getContext(), "[manager] Sleep for %lu ms", ms);
+			LOG_DEBUG(getContext(), MANAGER, "[manager] Sleep for %lu ms", ms);
 		}
+		MEM_PROFILER_PHASE(IDLE);
 		getLpm().idle(ms,
 			reinterpret_cast<uint32_t*>(&mSleepMemory), sizeof(mSleepMemory),
 			mLpmData, mLpmDataSize
@@ -136,23 +178,25 @@ public:
 
 	/** Waits the Network/WiFi connection. */
 	bool waitNetwork(bool sleepOnFailure = true) {
+		MEM_PROFILER_PHASE(CONNECT);
 		{
-			LOG_PRINTFLN(getContext(), "[manager] Waiting the WiFi");
+			LOG_INFO(getContext(), MANAGER, "[manager] Waiting the WiFi");
 			Time::Timer timer(getClock(), getConfig().NET_CONNECT_TM_MS);
 			while (!timer.expired() && WiFi.status() != WL_CONNECTED) {
-				LOG_PRINTFLN(getContext(), ".");
+				LOG_DEBUG(getContext(), MANAGER, ".");
 				delay(500);
 			}
 		}
 		bool connected = (WiFi.status() == WL_CONNECTED);
 		if (connected) {
-			LOG_PRINTFLN(getContext(), "[manager] Connected to WiFi");
-			LOG_PRINTFLN(getContext(), "[manager] IP: %s", WiFi.localIP().toString().c_str());
+			LOG_INFO(getContext(), MANAGER, "[manager] Connected to WiFi");
+			LOG_INFO(getContext(), MANAGER, "[manager] IP: %s", WiFi.localIP().toString().c_str());
+			uploadCrashLog();
 		} else {
-			LOG_PRINTFLN(getContext(), "[manager] ERROR, WiFi is not connected");
+			LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, WiFi is not connected");
 			if (sleepOnFailure) {
 				uint32_t retryTm = getConfig().NET_CONNECT_ERROR_RETRY_TM_MS;
-				LOG_PRINTFLN(getContext(), "Retry in %lu Ms", retryTm);
+				LOG_DEBUG(getContext(), MANAGER, "Retry in %lu Ms", retryTm);
 				idle(retryTm, false);
 			}
 		}
@@ -160,21 +204,22 @@ public:
 	}
 
 	bool connectServer(WiFiClientSecure &client, const String &host, uint16_t port, bool sleepOnFailure = true) {
-		LOG_PRINTFLN(getContext(), "[manager] Connecting to port: %u", port);
+		MEM_PROFILER_PHASE(CONNECT);
+		LOG_INFO(getContext(), MANAGER, "[manager] Connecting to port: %u", port);
 		bool connected = false;
 		if (client.connect(host.c_str(), port)) {
 			if (client.verifyCertChain(host.c_str())) {
 				connected = true;
 			} else {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Certificate verification failed");
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Certificate verification failed");
 			}
 		} else {
-			LOG_PRINTFLN(getContext(), "[manager] ERROR, Connection failed");
+			LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Connection failed");
 		}
 		if (connected) {
-			LOG_PRINTFLN(getContext(), "[manager] Connected to Server");
+			LOG_INFO(getContext(), MANAGER, "[manager] Connected to Server");
 		} else {
-			LOG_PRINTFLN(getContext(), "[manager] ERROR, Can't connect to Server");
+			LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Can't connect to Server");
 		}
 		return connected;
 	}
@@ -183,35 +228,38 @@ public:
 		bool res = false;
 		// CA certificate
 		{
-			File f = SPIFFS.open(Strings::FILE_NAME_CERT_CA_CRT, "r");
+			const Strings::RamString<> name(Strings::FILE_NAME_CERT_CA_CRT);
+			File f = SPIFFS.open(name, "r");
 			if (f) {
 				res = client.loadCACert(f);
 				f.close();
 			}
 			if (!res) {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Can't load: %s" , Strings::FILE_NAME_CERT_CA_CRT);
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Can't load: %s" , name.c_str());
 			}
 		}
 		// Public certificate
 		if (res) {
-			File f = SPIFFS.open(Strings::FILE_NAME_CERT_CRT, "r");
+			const Strings::RamString<> name(Strings::FILE_NAME_CERT_CRT);
+			File f = SPIFFS.open(name, "r");
 			if (f) {
 				res = client.loadCertificate(f);
 				f.close();
 			}
 			if (!res) {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Can't load: %s", Strings::FILE_NAME_CERT_CRT);
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Can't load: %s", name.c_str());
 			}
 		}
 		// Private certificate
 		if (res) {
-			File f = SPIFFS.open(Strings::FILE_NAME_CERT_KEY, "r");
+			const Strings::RamString<> name(Strings::FILE_NAME_CERT_KEY);
+			File f = SPIFFS.open(name, "r");
 			if (f) {
 				res = client.loadPrivateKey(f);
 				f.close();
 			}
 			if (!res) {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Can't load: %s", Strings::FILE_NAME_CERT_KEY);
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Can't load: %s", name.c_str());
 			}
 		}
 		return res;
@@ -225,12 +273,12 @@ public:
 		getClock().initRtc(ntpServer);
 		bool updated = (0 != getClock().rtc());
 		if (updated) {
-			LOG_PRINTFLN(getContext(), "[manager] NTP time: %lu", getClock().rtc());
+			LOG_INFO(getContext(), MANAGER, "[manager] NTP time: %lu", getClock().rtc());
 		} else {
-			LOG_PRINTFLN(getContext(), "[manager] ERROR, NTP time is not available");
+			LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, NTP time is not available");
 			if (sleepOnFailure) {
 				uint32_t retryTm = getConfig().NET_CONNECT_ERROR_RETRY_TM_MS;
-				LOG_PRINTFLN(getContext(), "Retry in %lu Ms", retryTm);
+				LOG_DEBUG(getContext(), MANAGER, "Retry in %lu Ms", retryTm);
 				idle(retryTm, false);
 			}
 		}
@@ -261,9 +309,8 @@ public:
 	/** Checks and installs the FW update using HTTP. */
 	HTTPUpdateResult checkFirmwareUpdateNotSecure() {
 		String url = Util::makeUrl(Strings::URL_MODEL_UPDATE_FW_NOT_S,
-				getConfig().SERVER_ADDR, getConfig().SERVER_HTTP_PORT
+				getConfig().SERVER_ADDR, getConfig().SERVER_HTTP_PORT, NULL, NULL, getId().c_str()
 		);
-		Util::setModelKey(url, Strings::MODEL_KEY_ID, getId());
 		getHttpUpdate().rebootOnUpdate(true);
 		HTTPUpdateResult res = getHttpUpdate().update(url);
 		switch (res) {
@@ -294,7 +341,7 @@ public:
 					getConfig().auth.fingerprints[0]
 				);
 			} else {
-				LOG_PRINTFLN(getContext(), "[manager] WARN, Fingerprints Update via HTTP");
+				LOG_WARN(getContext(), MANAGER, "[manager] WARN, Fingerprints Update via HTTP");
 				http.begin(Util::makeUrl(
 						Strings::URL_MODEL_FINGERPRINTS_NOT_S,
 						getConfig().SERVER_ADDR,
@@ -303,13 +350,13 @@ public:
 			}
 			int httpCode = http.GET();
 			if (httpCode > 0) {
-				LOG_PRINTFLN(getContext(), "[manager] Fingerprints Update, code: %i", httpCode);
+				LOG_INFO(getContext(), MANAGER, "[manager] Fingerprints Update, code: %i", httpCode);
 				if (httpCode == HTTP_CODE_OK) {
 					payload = http.getString();
 					res = true;
 				}
 			} else {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Fingerprints Update, error: %s",
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Fingerprints Update, error: %s",
 						http.errorToString(httpCode).c_str()
 				);
 			}
@@ -317,9 +364,9 @@ public:
 		}
 		bool updated = false;
 		if (payload.length()) {
-			DynamicJsonBuffer jsonBuffer;
+			ArenaJsonBuffer jsonBuffer(getContext());
 			JsonObject &root = jsonBuffer.parseObject(payload.begin());
-			JsonArray &list = root[Strings::PAYLOAD_KEY_RESULTS];
+			JsonArray &list = root[Strings::flash(Strings::PAYLOAD_KEY_RESULTS)];
 			if (JsonArray::invalid() != list) {
 				uint8_t idx = 0;
 				// Set new values
@@ -329,9 +376,9 @@ public:
 				{
 					JsonObject &item = *it;
 					if (JsonObject::invalid() != item) {
-						String value = item[Strings::PAYLOAD_KEY_VALUE];
+						String value = item[Strings::flash(Strings::PAYLOAD_KEY_VALUE)];
 						if (value.length()) {
-							LOG_PRINTFLN(getContext(), "[manager] Fingerprint: %s", value.c_str());
+							LOG_DEBUG(getContext(), MANAGER, "[manager] Fingerprint: %s", value.c_str());
 							if (!getConfig().auth.fingerprints[idx].equals(value)) {
 								getConfig().auth.fingerprints[idx] = value;
 								updated = true;
@@ -353,35 +400,30 @@ public:
 	/** Checks and installs the CA certificates. */
 	HTTPUpdateResult checkCaUpdate() {
 		String url = Util::makeUrl(Strings::URL_MODEL_CERT_CA,
-				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT
+				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT, Strings::CERT_FORM_DER
 		);
-		Util::setModelKey(url, Strings::MODEL_KEY_FORM, Strings::CERT_FORM_DER);
-		return getHttpUpdate().updateFile(Strings::FILE_NAME_CERT_CA_CRT, url, getConfig().auth.fingerprints[0], getConfig().auth.token);
+		return getHttpUpdate().updateFile(String(Strings::flash(Strings::FILE_NAME_CERT_CA_CRT)), url, getConfig().auth.fingerprints[0], getConfig().auth.token);
 	}
 
 	/** Checks and installs the client public certificate. */
 	HTTPUpdateResult checkCrtUpdate() {
 		String url = Util::makeUrl(Strings::URL_MODEL_CERT,
-				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT
+				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT, Strings::CERT_FORM_DER, Strings::CERT_TYPE_CRT
 		);
-		Util::setModelKey(url, Strings::MODEL_KEY_FORM, Strings::CERT_FORM_DER);
-		Util::setModelKey(url, Strings::MODEL_KEY_TYPE, Strings::CERT_TYPE_CRT);
-		return getHttpUpdate().updateFile(Strings::FILE_NAME_CERT_CRT, url, getConfig().auth.fingerprints[0], getConfig().auth.token);
+		return getHttpUpdate().updateFile(String(Strings::flash(Strings::FILE_NAME_CERT_CRT)), url, getConfig().auth.fingerprints[0], getConfig().auth.token);
 	}
 
 	/** Checks and installs the client private certificate. */
 	HTTPUpdateResult checkCrtKeyUpdate() {
 		String url = Util::makeUrl(Strings::URL_MODEL_CERT,
-				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT
+				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT, Strings::CERT_FORM_DER, Strings::CERT_TYPE_KEY
 		);
-		Util::setModelKey(url, Strings::MODEL_KEY_FORM, Strings::CERT_FORM_DER);
-		Util::setModelKey(url, Strings::MODEL_KEY_TYPE, Strings::CERT_TYPE_KEY);
-		return getHttpUpdate().updateFile(Strings::FILE_NAME_CERT_KEY, url, getConfig().auth.fingerprints[0], getConfig().auth.token);
+		return getHttpUpdate().updateFile(String(Strings::flash(Strings::FILE_NAME_CERT_KEY)), url, getConfig().auth.fingerprints[0], getConfig().auth.token);
 	}
 
 	/** Rotates fingerprints if current one is not valid anymore. */
 	RotateFingerprintsStatus::Type rotateServerFingerprints() {
-		LOG_PRINTFLN(getContext(), "[manager] Rotate fingerprints");
+		LOG_INFO(getContext(), MANAGER, "[manager] Rotate fingerprints");
 		bool updated = false;
 		{
 			WiFiClientSecure client;
@@ -390,7 +432,7 @@ public:
 				for (uint8_t i = 0; i < getConfig().auth.getMaxFingerprintsQty(); ++i) {
 					String &value = getConfig().auth.fingerprints[i];
 					if (value.length() && client.verify(value.c_str(), getConfig().SERVER_ADDR)) {
-						LOG_PRINTFLN(getContext(), "[manager] Switch to fingerprint: %s", value.c_str());
+						LOG_INFO(getContext(), MANAGER, "[manager] Switch to fingerprint: %s", value.c_str());
 						verified = true;
 						updated = getConfig().auth.resetFingerprints(0, i);
 						break;
@@ -400,7 +442,7 @@ public:
 					return RotateFingerprintsStatus::ERROR_VERIFY;
 				}
 			} else {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Rotate fingerprints: can't connect");
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Rotate fingerprints: can't connect");
 				return RotateFingerprintsStatus::ERROR;
 			}
 		}
@@ -421,18 +463,18 @@ public:
 			);
 			CharArrayBuffer<> reqPayload;
 			{
-				DynamicJsonBuffer jsonBuffer;
+				ArenaJsonBuffer jsonBuffer(getContext());
 				JsonObject &root = jsonBuffer.createObject();
-				root[Strings::USERNAME] = getId();
-				root[Strings::PASSWORD] = getId();
+				root[Strings::flash(Strings::USERNAME)] = getId();
+				root[Strings::flash(Strings::PASSWORD)] = getId();
 				root.printTo(reqPayload.get(), reqPayload.size());
 			}
 			HTTPClient http;
 			http.begin(url, getConfig().auth.fingerprints[0]);
-			http.addHeader(Strings::HEADER_CONTENT_TYPE, Strings::MIME_TYPE_APP_JSON);
+			http.addHeader(String(Strings::flash(Strings::HEADER_CONTENT_TYPE)), String(Strings::flash(Strings::MIME_TYPE_APP_JSON)));
 			int httpCode = http.POST(reqPayload.get());
 			if (httpCode > 0) {
-				LOG_PRINTFLN(getContext(), "[manager] Authentication, code: %i", httpCode);
+				LOG_INFO(getContext(), MANAGER, "[manager] Authentication, code: %i", httpCode);
 				switch(httpCode) {
 					case HTTP_CODE_OK:
 						payload = http.getString();
@@ -441,13 +483,13 @@ public:
 						res = AuthenticateStatus::ERROR_FORBIDDEN;
 						// no break
 					default:
-						LOG_PRINTFLN(getContext(), "[manager] ERROR, Authentication, error-payload: %s",
+						LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Authentication, error-payload: %s",
 							http.getString().c_str()
 						);
 						break;
 				}
 			} else {
-				LOG_PRINTFLN(getContext(), "[manager] ERROR, Authentication, error: %s",
+				LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Authentication, error: %s",
 					http.errorToString(httpCode).c_str()
 				);
 			}
@@ -457,12 +499,12 @@ public:
 		bool updated = false;
 		if (payload.length()) {
 			{
-				DynamicJsonBuffer jsonBuffer;
+				ArenaJsonBuffer jsonBuffer(getContext());
 				JsonObject &root = jsonBuffer.parseObject(payload.begin());
 				if (JsonObject::invalid() != root) {
-					const char *v = root[Strings::TOKEN];
+					const char *v = root[Strings::flash(Strings::TOKEN)];
 					if (v) {
-						LOG_PRINTFLN(getContext(), "[manager] Token: %s", v);
+						LOG_DEBUG(getContext(), MANAGER, "[manager] Token: %s", v);
 						res = AuthenticateStatus::OK;
 						if (!getConfig().auth.token.equals(v)) {
 							getConfig().auth.token = v;
@@ -470,7 +512,7 @@ public:
 						}
 					}
 				} else {
-					LOG_PRINTFLN(getContext(), "[config] ERROR, Authentication failure: can't pars");
+					LOG_ERROR(getContext(), CONFIG, "[config] ERROR, Authentication failure: can't pars");
 				}
 			}
 		}
@@ -488,6 +530,7 @@ public:
 	 *     Restart immediately when `false` is returned.
 	 */
 	bool check() {
+		MEM_PROFILER_PHASE(CHECK);
 		if (!isUpdateTime()) return true;
 		bool res = false;
 		if (isServerFingerprint()) {
@@ -507,9 +550,9 @@ public:
 					checkCrtUpdate();
 					checkCrtKeyUpdate();
 					// Check required files availability
-					if (SPIFFS.exists(Strings::FILE_NAME_CERT_CA_CRT)
-						&& SPIFFS.exists(Strings::FILE_NAME_CERT_CRT)
-						&& SPIFFS.exists(Strings::FILE_NAME_CERT_KEY))
+					if (SPIFFS.exists(Strings::RamString<>(Strings::FILE_NAME_CERT_CA_CRT))
+						&& SPIFFS.exists(Strings::RamString<>(Strings::FILE_NAME_CERT_CRT))
+						&& SPIFFS.exists(Strings::RamString<>(Strings::FILE_NAME_CERT_KEY)))
 					{
 						// System is healthy => Set the last update time-stamp
 						mSleepMemory.updateTsSec = getClock().rtc();
@@ -537,9 +580,46 @@ public:
 		return res;
 	}
 
+	/**
+	 * Uploads the log of the crashed run kept by `EspCrashLog`.
+	 * The log is kept until the upload succeeds, requires the paired board.
+	 */
+	bool uploadCrashLog() {
+#if BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+		if (!mCrashLog.isCrashed() || !isServerFingerprint() || !isAuthenticated()) {
+			return false;
+		}
+		uint8_t payload[EspCrashLog::RTC_SIZE];
+		const uint32_t size = mCrashLog.read(BufferView(payload, sizeof(payload)));
+		HTTPClient http;
+		http.begin(Util::makeUrl(Strings::URL_MODEL_CRASH_LOG,
+				getConfig().SERVER_ADDR, getConfig().SERVER_HTTPS_PORT
+			),
+			getConfig().auth.fingerprints[0]
+		);
+		{
+			String value(Strings::flash(Strings::TOKEN));
+			value += Strings::flash(Strings::SPACE);
+			value += getConfig().auth.token;
+			http.addHeader(String(Strings::flash(Strings::HEADER_AUTHORIZATION)), value);
+		}
+		http.addHeader(String(Strings::flash(Strings::HEADER_CONTENT_TYPE)), String(Strings::flash(Strings::MIME_TYPE_APP_OCTET_STREAM)));
+		http.addHeader(String(Strings::flash(Strings::HEADER_X_RESET_REASON)), String(mCrashLog.getReason()));
+		int httpCode = http.POST(payload, size);
+		http.end();
+		if (httpCode == HTTP_CODE_OK) {
+			LOG_INFO(getContext(), MANAGER, "[manager] Crash log uploaded");
+			mCrashLog.clear();
+			return true;
+		}
+		LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, Crash log upload, code: %i", httpCode);
+#endif
+		return false;
+	}
+
 	/** Send error message using HTTP */
 	void sendSos(const char *msg) {
-		LOG_PRINTFLN(getContext(), "[manager] ERROR, SOS: %s", msg);
+		LOG_ERROR(getContext(), MANAGER, "[manager] ERROR, SOS: %s", msg);
 		// TODO: send error using HTTP
 	}
 
@@ -592,6 +672,7 @@ private:
 	String											mId;
 	String											mName;
 	Context											mCtx;
+	Arena											mArena;
 	CONFIG_T											mConfig;
 	EspStorage										mConfigStorage;
 	EspLpm											mLpm;
@@ -600,29 +681,33 @@ private:
 	uint32_t											mLpmDataSize;
 	Time::EspClock									mClock;
 	HwUart											mHwUart;
+	AsyncPrint<BUTLER_ARDUINO_ESP_MANAGER_LOG_BUFFER_SIZE>	mLogPrint;
+#if BUTLER_ARDUINO_ESP_CRASH_LOG_SIZE
+	EspCrashLog										mCrashLog;
+#endif
 	EspHttpUpdate									mHttpUpdate;
 
 	void setupConfigMode() {
 		//// SETUP ////
-		LOG_PRINTFLN(getContext(), "[setup] CONFIG mode");
+		LOG_INFO(getContext(), SETUP, "[setup] CONFIG mode");
 		Butler::Arduino::CaptivePortal::WiFiConfig configPortal;
 		const char *ssid = getName().c_str();
 		configPortal.start(
 				ssid,
 				[&](Config::WiFiConfig& wifiConfig)
 		{
-			LOG_PRINTFLN(getContext(), "[setup] WiFi configuration arrived via HTTP");
+			LOG_INFO(getContext(), SETUP, "[setup] WiFi configuration arrived via HTTP");
 			bool changed = false;
 			// Verify
 			if (wifiConfig.isValid()) {
 				changed = !getConfig().wifi.isEqual(wifiConfig);
 				getConfig().wifi.set(wifiConfig);
 			} else {
-				LOG_PRINTFLN(getContext(), "[setup] ERROR, WiFi configuration isn't valid");
+				LOG_ERROR(getContext(), SETUP, "[setup] ERROR, WiFi configuration isn't valid");
 			}
 			// Store
 			if (changed) {
-				LOG_PRINTFLN(getContext(), "[setup] Configuration changed");
+				LOG_INFO(getContext(), SETUP, "[setup] Configuration changed");
 				// Store
 				getConfig().store(getContext(), getConfigStorage());
 			}
@@ -630,11 +715,11 @@ private:
 			restart();
 		});
 		//// SETUP END ////
-		LOG_PRINTFLN(getContext(), "#################################");
-		LOG_PRINTFLN(getContext(), "###  Butler device configurator");
-		LOG_PRINTFLN(getContext(), "### AP SSID     : %s", ssid);
-		LOG_PRINTFLN(getContext(), "### AP IP       : %s", WiFi.softAPIP().toString().c_str());
-		LOG_PRINTFLN(getContext(), "#################################");
+		LOG_INFO(getContext(), MANAGER, "#################################");
+		LOG_INFO(getContext(), MANAGER, "###  Butler device configurator");
+		LOG_INFO(getContext(), MANAGER, "### AP SSID     : %s", ssid);
+		LOG_INFO(getContext(), MANAGER, "### AP IP       : %s", WiFi.softAPIP().toString().c_str());
+		LOG_INFO(getContext(), MANAGER, "#################################");
 
 		//// EXECUTE ////
 		while (true) {
@@ -646,7 +731,7 @@ private:
 
 	void setupNormalMode() {
 		//// SETUP ////
-		LOG_PRINTFLN(getContext(), "[setup] NORMAL mode");
+		LOG_INFO(getContext(), SETUP, "[setup] NORMAL mode");
 		//// Initialize RESET pin ////
 		pinMode(getConfig().CFG_RESET_PIN, INPUT_PULLUP);
 		//// Check RESET request ////
@@ -660,7 +745,7 @@ private:
 			}
 			// Pin is still LOW => reset
 			if (v == LOW) {
-				LOG_PRINTFLN(getContext(), "[setup] Reset configuration");
+				LOG_INFO(getContext(), SETUP, "[setup] Reset configuration");
 				getConfigStorage().reset();
 				restart();
 			}
@@ -669,7 +754,7 @@ private:
 		if (!getLpm().check(getConfig().CFG_RESET_PIN,
 				reinterpret_cast<uint32_t*>(&mSleepMemory), sizeof(mSleepMemory),
 				mLpmData, mLpmDataSize)) {
-			LOG_PRINTFLN(getContext(), "Sleep persistence was not recovered");
+			LOG_INFO(getContext(), MANAGER, "Sleep persistence was not recovered");
 		}
 		//// NETWORK ////
 		WiFi.persistent(false);
@@ -677,18 +762,18 @@ private:
 		WiFi.hostname(getName().c_str());
 		WiFi.begin(getConfig().wifi.ssid.c_str(), getConfig().wifi.passphrase.c_str());
 		//// SETUP END ////
-		LOG_PRINTFLN(getContext(), "#################################");
-		LOG_PRINTFLN(getContext(), "###       Butler device");
-		LOG_PRINTFLN(getContext(), "### ID          : %s", getId().c_str());
-		LOG_PRINTFLN(getContext(), "### NAME        : %s", getName().c_str());
-		LOG_PRINTFLN(getContext(), "#################################");
+		LOG_INFO(getContext(), MANAGER, "#################################");
+		LOG_INFO(getContext(), MANAGER, "###       Butler device");
+		LOG_INFO(getContext(), MANAGER, "### ID          : %s", getId().c_str());
+		LOG_INFO(getContext(), MANAGER, "### NAME        : %s", getName().c_str());
+		LOG_INFO(getContext(), MANAGER, "#################################");
 	}
 
 	bool isUpdateTime() {
 		uint32_t now = getClock().rtc();
 		uint32_t lastUpdate = mSleepMemory.updateTsSec;
 		uint32_t nextUpdate = lastUpdate + 24*60*60L;
-		LOG_PRINTFLN(getContext(), "[manager] Last update, time: %lu sec", lastUpdate);
+		LOG_INFO(getContext(), MANAGER, "[manager] Last update, time: %lu sec", lastUpdate);
 		return !lastUpdate || (now && (nextUpdate < now));
 	}
 };
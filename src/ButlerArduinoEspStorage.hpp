@@ -28,6 +28,9 @@ namespace Arduino {
 
 class EspStorage: public Storage {
 public:
+	using Storage::read;
+	using Storage::write;
+
 	uint32_t size() {
 		return SPI_FLASH_SEC_SIZE;
 	}
@@ -32,15 +32,7 @@ typedef std::function<void(Config::WiFiConfig&)> WiFiConfig_f;
 
 class WiFiConfig {
 public:
-	WiFiConfig() {
-		webServer = new ESP8266WebServer(80);
-		dnsServer = new DNSServer();
-	}
-
-	~WiFiConfig() {
-		delete dnsServer;
-		delete webServer;
-	}
+	WiFiConfig(): webServer(80) {}
 
 	void start(const char *softApSsid, WiFiConfig_f handler) {
 		//// NETWORK ////
@@ -49,43 +41,43 @@ public:
 		WiFi.softAP(softApSsid);
 
 		//// WEB ////
-		webServer->onNotFound([=]{
+		webServer.onNotFound([=]{
 			// Redirect to Captive Portal if accessing some other IP
-			if (!webServer->hostHeader().equals(webServer->client().localIP().toString())) {
-				webServer->sendHeader("Location", String("http://") + webServer->client().localIP().toString(), true);
-				webServer->send(302, "text/plain", "");
-				webServer->client().stop();
+			if (!webServer.hostHeader().equals(webServer.client().localIP().toString())) {
+				webServer.sendHeader("Location", String("http://") + webServer.client().localIP().toString(), true);
+				webServer.send(302, "text/plain", "");
+				webServer.client().stop();
 			} else {
-				webServer->send(404);
+				webServer.send(404);
 			}
 		});
-		webServer->on("/", [=]{
+		webServer.on("/", [=]{
 			// Show Captive Portal
-			webServer->send(200, "text/html", FPSTR(Butler::Arduino::Html::WIFI_CONFIG_PAGE));
+			webServer.send(200, "text/html", FPSTR(Butler::Arduino::Html::WIFI_CONFIG_PAGE));
 		});
-		webServer->on("/wifiConfig", HTTP_POST, [=]{
+		webServer.on("/wifiConfig", HTTP_POST, [=]{
 			Config::WiFiConfig v;
-			v.ssid = webServer->arg(Butler::Arduino::Strings::SSID);
-			v.passphrase = webServer->arg(Butler::Arduino::Strings::PASSPHRASE);
-			webServer->send(204);
-			webServer->client().stop();
+			v.ssid = webServer.arg(String(Butler::Arduino::Strings::flash(Butler::Arduino::Strings::SSID)));
+			v.passphrase = webServer.arg(String(Butler::Arduino::Strings::flash(Butler::Arduino::Strings::PASSPHRASE)));
+			webServer.send(204);
+			webServer.client().stop();
 			handler(v);
 		});
-		webServer->begin();
+		webServer.begin();
 
 		//// DNS ////
-		dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
-		dnsServer->start(53, "*", WiFi.softAPIP());
+		dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
+		dnsServer.start(53, "*", WiFi.softAPIP());
 	}
 
 	void process() {
-		dnsServer->processNextRequest();
-		webServer->handleClient();
+		dnsServer.processNextRequest();
+		webServer.handleClient();
 	}
 
 private:
-	ESP8266WebServer								*webServer;
-	DNSServer										*dnsServer;
+	ESP8266WebServer								webServer;
+	DNSServer										dnsServer;
 };
 
 } // CaptivePortal
@@ -0,0 +1,380 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Streaming formatter implementation.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+/* Internal Includes */
+#include "ButlerArduinoFormat.h"
+
+
+/** The 64-bit division is too expensive for AVR, `ll` values are truncated to `long` */
+#ifndef BUTLER_ARDUINO_FORMAT_LONG_LONG
+	#ifdef __AVR__
+		#define BUTLER_ARDUINO_FORMAT_LONG_LONG			0
+	#else
+		#define BUTLER_ARDUINO_FORMAT_LONG_LONG			1
+	#endif
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+namespace Format {
+
+void Writer::put(const char *str, size_t size) {
+	if (size >= sizeof(mChunk)) {
+		// Long run => no copy
+		flush();
+		mOut.write(reinterpret_cast<const uint8_t*>(str), size);
+		mTotal += size;
+		return;
+	}
+	while (size) {
+		size_t qty = sizeof(mChunk) - mQty;
+		if (qty > size) {
+			qty = size;
+		}
+		memcpy(mChunk + mQty, str, qty);
+		mQty += qty;
+		str += qty;
+		size -= qty;
+		if (mQty == sizeof(mChunk)) {
+			flush();
+		}
+	}
+}
+
+void Writer::flush() {
+	if (mQty) {
+		mOut.write(reinterpret_cast<const uint8_t*>(mChunk), mQty);
+		mTotal += mQty;
+		mQty = 0;
+	}
+}
+
+namespace {
+
+enum Flag {
+	FLAG_LEFT		= 0x01,
+	FLAG_PLUS		= 0x02,
+	FLAG_SPACE		= 0x04,
+	FLAG_ALT		= 0x08,
+	FLAG_ZERO		= 0x10
+};
+
+enum Length {
+	LENGTH_NONE,
+	LENGTH_CHAR,
+	LENGTH_SHORT,
+	LENGTH_LONG,
+	LENGTH_LONG_LONG,
+	LENGTH_SIZE
+};
+
+struct Spec {
+	uint8_t												flags;
+	int													width;
+	int													precision; // negative if not set
+};
+
+#if BUTLER_ARDUINO_FORMAT_LONG_LONG
+typedef long long										Signed;
+typedef unsigned long long								Magnitude;
+#else
+typedef long											Signed;
+typedef unsigned long									Magnitude;
+#endif
+
+inline char readChar(const char *p, bool isP) {
+	return isP ? pgm_read_byte(p) : *p;
+}
+
+void pad(Writer &out, const Spec &spec, size_t size) {
+	if (spec.width > 0 && static_cast<size_t>(spec.width) > size) {
+		out.put(' ', spec.width - size);
+	}
+}
+
+void putString(Writer &out, const Spec &spec, const char *str, bool isP) {
+	if (!str) {
+		str = "(null)";
+		isP = false;
+	}
+	size_t size = 0;
+	while ((spec.precision < 0 || size < static_cast<size_t>(spec.precision)) && readChar(str + size, isP)) {
+		size++;
+	}
+	if (!(spec.flags & FLAG_LEFT)) {
+		pad(out, spec, size);
+	}
+	if (isP) {
+		for (size_t i = 0; i < size; i++) {
+			out.put(static_cast<char>(pgm_read_byte(str + i)));
+		}
+	} else {
+		out.put(str, size);
+	}
+	if (spec.flags & FLAG_LEFT) {
+		pad(out, spec, size);
+	}
+}
+
+template<typename VALUE_T>
+void putInteger(Writer &out, const Spec &spec, VALUE_T v, bool negative, bool isSigned, char conv) {
+	char digits[(sizeof(VALUE_T) * 8 + 2) / 3];
+	const uint8_t base = conv == 'o' ? 8 : ((conv == 'x' || conv == 'X' || conv == 'p') ? 16 : 10);
+	const char alpha = conv == 'X' ? 'A' : 'a';
+	const bool zero = !v;
+	uint8_t qty = 0;
+	while (v) {
+		const uint8_t d = v % base;
+		digits[qty++] = d < 10 ? '0' + d : alpha + d - 10;
+		v /= base;
+	}
+	// The precision is the minimum digits quantity
+	const int precision = spec.precision < 0 ? 1 : spec.precision;
+	size_t zeros = precision > qty ? precision - qty : 0;
+	char prefix[2];
+	uint8_t prefixQty = 0;
+	if (negative) {
+		prefix[prefixQty++] = '-';
+	} else if (isSigned && (spec.flags & FLAG_PLUS)) {
+		prefix[prefixQty++] = '+';
+	} else if (isSigned && (spec.flags & FLAG_SPACE)) {
+		prefix[prefixQty++] = ' ';
+	}
+	if ((spec.flags & FLAG_ALT) || conv == 'p') {
+		if (base == 16 && !zero) {
+			prefix[prefixQty++] = '0';
+			prefix[prefixQty++] = conv == 'X' ? 'X' : 'x';
+		} else if (base == 8 && !zeros) {
+			zeros = 1;
+		}
+	}
+	if ((spec.flags & FLAG_ZERO) && !(spec.flags & FLAG_LEFT) && spec.precision < 0
+		&& spec.width > static_cast<int>(prefixQty + zeros + qty))
+	{
+		zeros = spec.width - prefixQty - qty;
+	}
+	const size_t size = prefixQty + zeros + qty;
+	if (!(spec.flags & FLAG_LEFT)) {
+		pad(out, spec, size);
+	}
+	out.put(prefix, prefixQty);
+	out.put('0', zeros);
+	while (qty) {
+		out.put(digits[--qty]);
+	}
+	if (spec.flags & FLAG_LEFT) {
+		pad(out, spec, size);
+	}
+}
+
+/** Separated to keep the buffers out of the stack if no floats */
+__attribute__((noinline)) void putFloat(Writer &out, const Spec &spec, double v, char conv) {
+	char fmt[16];
+	uint8_t i = 0;
+	fmt[i++] = '%';
+	if (spec.flags & FLAG_LEFT) fmt[i++] = '-';
+	if (spec.flags & FLAG_PLUS) fmt[i++] = '+';
+	if (spec.flags & FLAG_SPACE) fmt[i++] = ' ';
+	if (spec.flags & FLAG_ALT) fmt[i++] = '#';
+	if (spec.flags & FLAG_ZERO) fmt[i++] = '0';
+	fmt[i++] = '*';
+	fmt[i++] = '.';
+	fmt[i++] = '*';
+	fmt[i++] = conv;
+	fmt[i] = '\0';
+	char buf[32];
+	const int qty = snprintf(buf, sizeof(buf), fmt, spec.width, spec.precision < 0 ? 6 : spec.precision, v);
+	if (qty > 0) {
+		out.put(buf, static_cast<size_t>(qty) < sizeof(buf) ? qty : sizeof(buf) - 1);
+	}
+}
+
+} // namespace
+
+size_t vprint(Writer &out, bool fmtP, const char *fmt, va_list ap) {
+	for (;;) {
+		// Literal run
+		if (fmtP) {
+			char c;
+			while ((c = pgm_read_byte(fmt)) && c != '%') {
+				out.put(c);
+				fmt++;
+			}
+		} else {
+			const char *end = fmt;
+			while (*end && *end != '%') {
+				end++;
+			}
+			out.put(fmt, end - fmt);
+			fmt = end;
+		}
+		if (!readChar(fmt, fmtP)) {
+			break;
+		}
+		fmt++;
+		// Flags
+		Spec spec = {0, 0, -1};
+		char c;
+		for (;; fmt++) {
+			c = readChar(fmt, fmtP);
+			if (c == '-') spec.flags |= FLAG_LEFT;
+			else if (c == '+') spec.flags |= FLAG_PLUS;
+			else if (c == ' ') spec.flags |= FLAG_SPACE;
+			else if (c == '#') spec.flags |= FLAG_ALT;
+			else if (c == '0') spec.flags |= FLAG_ZERO;
+			else break;
+		}
+		// Width
+		if (c == '*') {
+			spec.width = va_arg(ap, int);
+			if (spec.width < 0) {
+				spec.flags |= FLAG_LEFT;
+				spec.width = -spec.width;
+			}
+			c = readChar(++fmt, fmtP);
+		} else {
+			for (; c >= '0' && c <= '9'; c = readChar(++fmt, fmtP)) {
+				spec.width = spec.width * 10 + (c - '0');
+			}
+		}
+		// Precision
+		if (c == '.') {
+			c = readChar(++fmt, fmtP);
+			if (c == '*') {
+				spec.precision = va_arg(ap, int);
+				if (spec.precision < 0) {
+					spec.precision = -1;
+				}
+				c = readChar(++fmt, fmtP);
+			} else {
+				spec.precision = 0;
+				for (; c >= '0' && c <= '9'; c = readChar(++fmt, fmtP)) {
+					spec.precision = spec.precision * 10 + (c - '0');
+				}
+			}
+		}
+		// Length
+		Length length = LENGTH_NONE;
+		if (c == 'h') {
+			length = LENGTH_SHORT;
+			c = readChar(++fmt, fmtP);
+			if (c == 'h') {
+				length = LENGTH_CHAR;
+				c = readChar(++fmt, fmtP);
+			}
+		} else if (c == 'l') {
+			length = LENGTH_LONG;
+			c = readChar(++fmt, fmtP);
+			if (c == 'l') {
+				length = LENGTH_LONG_LONG;
+				c = readChar(++fmt, fmtP);
+			}
+		} else if (c == 'j') {
+			length = LENGTH_LONG_LONG;
+			c = readChar(++fmt, fmtP);
+		} else if (c == 'z' || c == 't') {
+			length = LENGTH_SIZE;
+			c = readChar(++fmt, fmtP);
+		}
+		if (!c) {
+			break;
+		}
+		fmt++;
+		// Conversion
+		switch (c) {
+			case 'd':
+			case 'i':
+			{
+				Signed v;
+				switch (length) {
+					case LENGTH_CHAR: v = static_cast<signed char>(va_arg(ap, int)); break;
+					case LENGTH_SHORT: v = static_cast<short>(va_arg(ap, int)); break;
+					case LENGTH_LONG: v = va_arg(ap, long); break;
+					case LENGTH_LONG_LONG: v = va_arg(ap, long long); break;
+					case LENGTH_SIZE: v = va_arg(ap, ptrdiff_t); break;
+					default: v = va_arg(ap, int); break;
+				}
+				const Magnitude m = v < 0 ? static_cast<Magnitude>(0) - static_cast<Magnitude>(v) : static_cast<Magnitude>(v);
+				putInteger(out, spec, m, v < 0, true, c);
+			}
+				break;
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+			{
+				Magnitude v;
+				switch (length) {
+					case LENGTH_CHAR: v = static_cast<unsigned char>(va_arg(ap, unsigned int)); break;
+					case LENGTH_SHORT: v = static_cast<unsigned short>(va_arg(ap, unsigned int)); break;
+					case LENGTH_LONG: v = va_arg(ap, unsigned long); break;
+					case LENGTH_LONG_LONG: v = va_arg(ap, unsigned long long); break;
+					case LENGTH_SIZE: v = va_arg(ap, size_t); break;
+					default: v = va_arg(ap, unsigned int); break;
+				}
+				putInteger(out, spec, v, false, false, c);
+			}
+				break;
+			case 'p':
+				putInteger(out, spec, static_cast<Magnitude>(reinterpret_cast<uintptr_t>(va_arg(ap, void*))), false, false, c);
+				break;
+			case 'c':
+			{
+				const char v = static_cast<char>(va_arg(ap, int));
+				if (!(spec.flags & FLAG_LEFT)) {
+					pad(out, spec, 1);
+				}
+				out.put(v);
+				if (spec.flags & FLAG_LEFT) {
+					pad(out, spec, 1);
+				}
+			}
+				break;
+			case 's':
+				putString(out, spec, va_arg(ap, const char*), false);
+				break;
+			case 'S':
+				putString(out, spec, va_arg(ap, const char*), true);
+				break;
+			case 'e':
+			case 'E':
+			case 'f':
+			case 'F':
+			case 'g':
+			case 'G':
+			case 'a':
+			case 'A':
+				putFloat(out, spec, va_arg(ap, double), c);
+				break;
+			case '%':
+				out.put('%');
+				break;
+			default:
+				// Unknown => as is
+				out.put('%');
+				out.put(c);
+				break;
+		}
+	}
+	return out.total();
+}
+
+} // Format
+
+}}
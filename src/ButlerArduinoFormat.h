@@ -0,0 +1,104 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Streaming formatter implementation.
+ *    Writes the `printf` like output straight to the `Print` without
+ *    the line buffer.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_FORMAT_H_
+#define BUTLER_ARDUINO_FORMAT_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+/* Internal Includes */
+#include "ButlerArduinoPrint.hpp"
+
+
+/** Bytes collected before the `Print::write` call */
+#ifndef BUTLER_ARDUINO_FORMAT_CHUNK_SIZE
+	#define BUTLER_ARDUINO_FORMAT_CHUNK_SIZE			16
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+namespace Format {
+
+/**
+ * Collects the short runs and passes them to the `Print` by chunks,
+ * the long strings are passed directly.
+ */
+class Writer {
+public:
+	Writer(Print &out): mOut(out), mQty(0), mTotal(0) {}
+
+	void put(char c) {
+		mChunk[mQty++] = c;
+		if (mQty == sizeof(mChunk)) {
+			flush();
+		}
+	}
+
+	void put(const char *str, size_t size);
+
+	void put(char c, size_t qty) {
+		while (qty--) {
+			put(c);
+		}
+	}
+
+	/** Writes the collected bytes */
+	void flush();
+
+	/** Gets the written bytes quantity */
+	size_t total() const { return mTotal + mQty; }
+
+private:
+	Print												&mOut;
+	char												mChunk[BUTLER_ARDUINO_FORMAT_CHUNK_SIZE];
+	uint8_t												mQty;
+	size_t												mTotal;
+
+	Writer(const Writer&);
+	Writer& operator=(const Writer&);
+};
+
+/**
+ * Writes the formatted string like `vsnprintf`, the format is in flash if `fmtP` is set.
+ * Supported: flags `-+ #0`, width and precision (also `*`),
+ * lengths `hh h l ll z j t`, conversions `d i u o x X c s p %`
+ * and `S` for the string in flash, the floats are formatted by `snprintf`.
+ * Returns the written bytes quantity.
+ */
+size_t vprint(Writer &out, bool fmtP, const char *fmt, va_list ap);
+
+inline size_t vprint(Print &out, bool fmtP, const char *fmt, va_list ap) {
+	Writer writer(out);
+	vprint(writer, fmtP, fmt, ap);
+	writer.flush();
+	return writer.total();
+}
+
+inline size_t print(Print &out, bool fmtP, const char *fmt, ...) {
+	va_list ap;
+	va_start(ap, fmt);
+	size_t res = vprint(out, fmtP, fmt, ap);
+	va_end(ap);
+	return res;
+}
+
+} // Format
+
+}}
+
+#endif // BUTLER_ARDUINO_FORMAT_H_
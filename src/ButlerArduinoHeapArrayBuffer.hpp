@@ -24,15 +24,26 @@ namespace Arduino {
 
 template<typename TYPE_T>
 struct HeapArrayBufferBase: public BufferBase<TYPE_T> {
-		HeapArrayBufferBase(): mSize(0), mBuf(NULL) {}
-		HeapArrayBufferBase(uint32_t size): mSize(size), mBuf(new TYPE_T[mSize]) {}
+		HeapArrayBufferBase(): mSize(0), mCapacity(0), mBuf(NULL) {}
+		HeapArrayBufferBase(uint32_t size): mSize(size), mCapacity(size), mBuf(new TYPE_T[mSize]) {}
 		~HeapArrayBufferBase() {delete[] mBuf;}
 		TYPE_T* get() {return mBuf;}
 		const TYPE_T* get() const {return mBuf;}
 		uint32_t size() const {return mSize;}
-		void resize(uint32_t size) {delete[] mBuf; mSize = size; mBuf = new TYPE_T[mSize];}
+		/** Gets the allocated array size */
+		uint32_t capacity() const {return mCapacity;}
+		/** Changes the size, the content is not kept. Reallocates only to grow. */
+		void resize(uint32_t size) {
+			if (size > mCapacity) {
+				delete[] mBuf;
+				mBuf = new TYPE_T[size];
+				mCapacity = size;
+			}
+			mSize = size;
+		}
 	private:
 		uint32_t										mSize;
+		uint32_t										mCapacity;
 		TYPE_T											*mBuf;
 };
 
@@ -42,6 +53,10 @@ struct HeapArrayBuffer: public HeapArrayBufferBase<uint8_t>, public Buffer {
 	uint8_t* get() { return HeapArrayBufferBase<uint8_t>::get(); }
 	const uint8_t* get() const { return HeapArrayBufferBase<uint8_t>::get(); }
 	uint32_t size() const { return HeapArrayBufferBase<uint8_t>::size(); }
+	BufferView view() { return Buffer::view(); }
+	ConstBufferView view() const { return Buffer::view(); }
+	operator BufferView() { return view(); }
+	operator ConstBufferView() const { return view(); }
 };
 
 struct CharHeapArrayBuffer: public HeapArrayBufferBase<char> {
@@ -0,0 +1,87 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Heap guard implementation.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <stddef.h>
+#include <stdlib.h>
+/* Internal Includes */
+#include "ButlerArduinoHeapGuard.h"
+
+
+namespace Butler {
+namespace Arduino {
+
+namespace HeapGuardPrivate {
+
+volatile bool											locked = false;
+volatile uint32_t										violationsQty = 0;
+
+inline void check() {
+	if (locked) {
+		++violationsQty;
+#if BUTLER_NO_HEAP_AFTER_SETUP_TRAP
+		abort();
+#endif
+	}
+}
+
+} // HeapGuardPrivate
+
+namespace HeapGuard {
+
+void lock() {
+	HeapGuardPrivate::locked = true;
+}
+
+void unlock() {
+	HeapGuardPrivate::locked = false;
+}
+
+bool isLocked() {
+	return HeapGuardPrivate::locked;
+}
+
+uint32_t getViolationsQty() {
+	return HeapGuardPrivate::violationsQty;
+}
+
+} // HeapGuard
+
+}}
+
+#if BUTLER_NO_HEAP_AFTER_SETUP
+
+extern "C" {
+
+void* __real_malloc(size_t size);
+void* __real_realloc(void *ptr, size_t size);
+void* __real_calloc(size_t num, size_t size);
+
+void* __wrap_malloc(size_t size) {
+	Butler::Arduino::HeapGuardPrivate::check();
+	return __real_malloc(size);
+}
+
+void* __wrap_realloc(void *ptr, size_t size) {
+	Butler::Arduino::HeapGuardPrivate::check();
+	return __real_realloc(ptr, size);
+}
+
+void* __wrap_calloc(size_t num, size_t size) {
+	Butler::Arduino::HeapGuardPrivate::check();
+	return __real_calloc(num, size);
+}
+
+} // extern "C"
+
+#endif // BUTLER_NO_HEAP_AFTER_SETUP
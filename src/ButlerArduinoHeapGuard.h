@@ -0,0 +1,54 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Heap guard declaration.
+ *    Detects the heap usage after `setup()`.
+ *    Enabled by the `BUTLER_NO_HEAP_AFTER_SETUP` build flag together with
+ *    the linker flags `-Wl,--wrap=malloc -Wl,--wrap=realloc -Wl,--wrap=calloc`.
+ *    Set `BUTLER_NO_HEAP_AFTER_SETUP_TRAP` to abort on the first allocation
+ *    instead of counting.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_HEAP_GUARD_H_
+#define BUTLER_ARDUINO_HEAP_GUARD_H_
+
+/* System Includes */
+#include <stdint.h>
+/* Internal Includes */
+
+
+#ifndef BUTLER_NO_HEAP_AFTER_SETUP
+	#define BUTLER_NO_HEAP_AFTER_SETUP					0
+#endif
+
+#ifndef BUTLER_NO_HEAP_AFTER_SETUP_TRAP
+	#define BUTLER_NO_HEAP_AFTER_SETUP_TRAP				0
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+namespace HeapGuard {
+
+/** Forbids the heap usage. Call at the end of `setup()`. */
+void lock();
+
+void unlock();
+
+bool isLocked();
+
+/** Gets the allocation calls quantity while locked */
+uint32_t getViolationsQty();
+
+} // HeapGuard
+
+}}
+
+#endif // BUTLER_ARDUINO_HEAP_GUARD_H_
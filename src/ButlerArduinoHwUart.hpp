@@ -31,6 +31,8 @@ struct HwUartConfig {
 
 class HwUart: public Uart {
 public:
+	using Uart::write;
+
 	HwUart(const HwUartConfig& config) {
 		Serial.begin(config.speed);
 		while (!Serial);
@@ -42,12 +44,16 @@ public:
 
 	size_t write(uint8_t c) { return Serial.write(c); }
 
+	size_t write(const uint8_t buffer[], size_t size) { return Serial.write(buffer, size); }
+
 	size_t print(const char c[]) { return Serial.print(c); }
 
 	size_t println(const char c[]) { return Serial.println(c); }
 
 	void flush(void) { Serial.flush(); }
 
+	int availableForWrite() { return Serial.availableForWrite(); }
+
 	int available(void) { return Serial.available(); }
 };
 
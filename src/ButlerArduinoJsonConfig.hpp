@@ -16,6 +16,7 @@
 
 /* System Includes */
 #include <stdint.h>
+#include <string.h>
 #include <ArduinoJson.h>
 /* Internal Includes */
 #include "ButlerArduinoStrings.hpp"
@@ -23,6 +24,10 @@
 #include "ButlerArduinoLogger.hpp"
 #include "ButlerArduinoContext.hpp"
 #include "ButlerArduinoHeapArrayBuffer.hpp"
+#include "ButlerArduinoByteWriter.hpp"
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoArena.hpp"
+#include "ButlerArduinoArenaJsonBuffer.hpp"
 
 
 namespace Butler {
@@ -56,6 +61,7 @@ public:
 
 	virtual ~JsonConfig() {}
 
+	/** The name is in flash like `Strings::WIFI` */
 	void addNode(const char *name, JsonConfigBase &config) {
 		if (name && mEmptyNodeIdx < NODE_QTY) {
 			mNodes[mEmptyNodeIdx++] = Node(name, config);
@@ -63,39 +69,51 @@ public:
 	}
 
 	bool update(Context& gCtx, char jsonString[]) {
-		LOG_PRINTFLN(gCtx, "[config] Update");
-		DynamicJsonBuffer jsonBuffer;
+		LOG_INFO(gCtx, CONFIG, "[config] Update");
+		ArenaJsonBuffer jsonBuffer(gCtx);
 		JsonObject& root = jsonBuffer.parseObject(&jsonString[0]);
 		// Check if parsing succeeds
 		if (!root.success()) {
-			LOG_PRINTFLN(gCtx, "[config] ERROR, Can't pars");
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Can't pars");
 			return false;
 		}
 		return decode(root);
 	}
 
 	bool load(Context &gCtx, Storage &storage) {
-		LOG_PRINTFLN(gCtx, "[config] Load");
+		LOG_INFO(gCtx, CONFIG, "[config] Load");
 		uint32_t readSize = storage.readSize();
 		if (readSize > storage.size()) {
-			LOG_PRINTFLN(gCtx, "[config] ERROR, Wrong size: %lu", readSize);
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Wrong size: %lu", readSize);
 			return false;
 		}
 		if (readSize == 0) {
-			LOG_PRINTFLN(gCtx, "[config] ERROR, Empty");
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Empty");
 			return false;
 		}
-		HeapArrayBuffer buffer(readSize);
+		ArenaBuffer buffer(gCtx.arena, readSize);
 		if (!storage.read(buffer)) {
-			LOG_PRINTFLN(gCtx, "[config] ERROR, Corrupted");
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Corrupted");
 			return false;
 		}
-		LOG_PRINTFLN_LONG(gCtx, "[config] %s", reinterpret_cast<char*>(buffer.get()));
-		DynamicJsonBuffer jsonBuffer;
-		JsonObject& root = jsonBuffer.parseObject(buffer.get());
+		return load(gCtx, buffer.view());
+	}
+
+	/**
+	 * Loads the configuration from the null terminated JSON string.
+	 * The string is parsed in place, so the view content is modified.
+	 */
+	bool load(Context &gCtx, const BufferView &json) {
+		if (!memchr(json.get(), '\0', json.size())) {
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Not terminated");
+			return false;
+		}
+		LOG_DEBUG_LONG(gCtx, CONFIG, "[config] %s", reinterpret_cast<char*>(json.get()));
+		ArenaJsonBuffer jsonBuffer(gCtx);
+		JsonObject& root = jsonBuffer.parseObject(reinterpret_cast<char*>(json.get()));
 		// Check if parsing succeeds
 		if (!root.success()) {
-			LOG_PRINTFLN(gCtx, "[config] ERROR, Can't pars");
+			LOG_ERROR(gCtx, CONFIG, "[config] ERROR, Can't pars");
 			return false;
 		}
 		decode(root);
@@ -103,16 +121,29 @@ public:
 	}
 
 	void store(Context &gCtx, Storage &storage) {
-		LOG_PRINTFLN(gCtx, "[config] Store");
-		Butler::Arduino::HeapArrayBuffer buffer;
+		ByteWriter writer;
+		store(gCtx, storage, writer);
+	}
+
+	/**
+	 * Stores the configuration serialized to the writer.
+	 * The writer keeps its capacity, so reusing it avoids the allocations.
+	 */
+	void store(Context &gCtx, Storage &storage, ByteWriter &writer) {
+		LOG_INFO(gCtx, CONFIG, "[config] Store");
+		writer.clear();
 		{
-			DynamicJsonBuffer jsonBuffer;
+			ArenaJsonBuffer jsonBuffer(gCtx);
 			JsonObject& root = jsonBuffer.createObject();
 			encode(root, jsonBuffer);
-			buffer.resize(root.measureLength() + 1);
-			root.printTo(reinterpret_cast<char*>(buffer.get()), buffer.size());
+			if (!writer.capacity()) {
+				// Allocate once instead of growing
+				writer.reserve(root.measureLength() + 1);
+			}
+			root.printTo(writer);
+			writer.write(static_cast<uint8_t>('\0'));
 		}
-		storage.write(buffer);
+		storage.write(writer.view());
 	}
 
 protected:
@@ -122,7 +153,7 @@ protected:
 			if (node.isValid() && node.mConfig->isValid()) {
 				JsonObject &o = jsonBuffer.createObject();
 				node.mConfig->encode(o, jsonBuffer);
-				json[node.mName] = o;
+				json[Strings::flash(node.mName)] = o;
 			}
 		}
 	}
@@ -132,7 +163,7 @@ protected:
 		for (int i = 0; i < mEmptyNodeIdx; ++i) {
 			Node &node = mNodes[i];
 			if (node.isValid()) {
-				JsonObject &o = json[node.mName];
+				JsonObject &o = json[Strings::flash(node.mName)];
 				if (JsonObject::invalid() != o) {
 					updated = node.mConfig->decode(o) || updated;
 				}
@@ -23,6 +23,9 @@
 /* Internal Includes */
 #include "ButlerArduinoContext.hpp"
 #include "ButlerArduinoPrint.hpp"
+#include "ButlerArduinoFormat.h"
+#include "ButlerArduinoTime.hpp"
+#include "ButlerArduinoRingBuffer.hpp"
 
 
 #ifndef LOG_ENABLED
@@ -33,6 +36,22 @@
 	#define LOG_MEM_ENABLED								0
 #endif
 
+/**
+ * Binary logging, see `Logger::logln_B`.
+ * Decode the output with `extras/logdecoder` and the firmware ELF.
+ */
+#ifndef LOG_BINARY_ENABLED
+	#define LOG_BINARY_ENABLED							0
+#endif
+
+#ifndef LOG_BINARY_BUFFER_SIZE
+	#define LOG_BINARY_BUFFER_SIZE						128
+#endif
+
+#ifndef LOG_BINARY_RECORD_SIZE_MAX
+	#define LOG_BINARY_RECORD_SIZE_MAX					48
+#endif
+
 #ifdef __AVR__
 	#define BUTLER_PSTR(s)								PSTR(s)
 	#define BUTLER_PSTR_ENABLED							1
@@ -44,13 +63,109 @@
 	#define BUTLER_PSTR_ENABLED							0
 #endif
 
-#if LOG_ENABLED
+// The format address in the firmware is the record ID, the format is never read by the device
+#define BUTLER_LOG_ID(s)								PSTR(s)
+
+#if LOG_ENABLED && LOG_BINARY_ENABLED
+	#define LOG_PRINTFLN(ctx, fmt, ...)			Butler::Arduino::Logger::logln_B(ctx, BUTLER_LOG_ID(fmt), ##__VA_ARGS__)
+	#define LOG_PRINTFLN_LONG(ctx, fmt, str)	Butler::Arduino::Logger::logln_B_long(ctx, BUTLER_LOG_ID(fmt), str)
+	#define LOG_FLUSH(ctx)						Butler::Arduino::Logger::flush(ctx)
+#elif LOG_ENABLED
 	#define LOG_PRINTFLN(ctx, fmt, ...)			Butler::Arduino::Logger::logln_I(ctx, BUTLER_PSTR(fmt), ##__VA_ARGS__)
 	#define LOG_PRINTFLN_LONG(ctx, fmt, str)	Butler::Arduino::Logger::logln_I_long(ctx, BUTLER_PSTR(fmt), str)
+	#define LOG_FLUSH(ctx)						Butler::Arduino::Logger::flush(ctx)
 #else
 	#define LOG_PRINTFLN(ctx, fmt, ...)			((void)0)
 	#define LOG_PRINTFLN_LONG(ctx, fmt, str)	((void)0)
+	#define LOG_FLUSH(ctx)						((void)0)
+#endif
+
+/**
+ * Severity levels, resolved at compile time:
+ *
+ *     LOG_WARN(ctx, MANAGER, "[manager] WARN, Retry");
+ *
+ * is compiled only if `LOG_LEVEL_MANAGER >= LOG_LEVEL_WARN`, otherwise
+ * neither the call, the format nor the arguments are in the firmware.
+ * Every tag has own threshold `LOG_LEVEL_<TAG>`, the default is `LOG_LEVEL`.
+ * The threshold must expand to the plain number, e.g.
+ * `-D LOG_LEVEL=LOG_LEVEL_ERROR -D LOG_LEVEL_CONFIG=LOG_LEVEL_DEBUG`.
+ * The unknown tag is the compilation error.
+ */
+#define LOG_LEVEL_NONE									0
+#define LOG_LEVEL_ERROR									1
+#define LOG_LEVEL_WARN									2
+#define LOG_LEVEL_INFO									3
+#define LOG_LEVEL_DEBUG									4
+
+#ifndef LOG_LEVEL
+	#if LOG_ENABLED
+		#define LOG_LEVEL								LOG_LEVEL_DEBUG
+	#else
+		#define LOG_LEVEL								LOG_LEVEL_NONE
+	#endif
+#endif
+
+#ifndef LOG_LEVEL_APP
+	#define LOG_LEVEL_APP								LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_CONFIG
+	#define LOG_LEVEL_CONFIG							LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LOOP
+	#define LOG_LEVEL_LOOP								LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LPM
+	#define LOG_LEVEL_LPM								LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_MEM
+	#define LOG_LEVEL_MEM								LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_MANAGER
+	#define LOG_LEVEL_MANAGER							LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SETUP
+	#define LOG_LEVEL_SETUP								LOG_LEVEL
 #endif
+#ifndef LOG_LEVEL_UPDATE
+	#define LOG_LEVEL_UPDATE							LOG_LEVEL
+#endif
+
+#define LOG_ERROR(ctx, tag, ...)				BUTLER_LOG_AT(LOG_LEVEL_ERROR, tag, LOG_PRINTFLN)(ctx, __VA_ARGS__)
+#define LOG_WARN(ctx, tag, ...)					BUTLER_LOG_AT(LOG_LEVEL_WARN, tag, LOG_PRINTFLN)(ctx, __VA_ARGS__)
+#define LOG_INFO(ctx, tag, ...)					BUTLER_LOG_AT(LOG_LEVEL_INFO, tag, LOG_PRINTFLN)(ctx, __VA_ARGS__)
+#define LOG_DEBUG(ctx, tag, ...)				BUTLER_LOG_AT(LOG_LEVEL_DEBUG, tag, LOG_PRINTFLN)(ctx, __VA_ARGS__)
+#define LOG_DEBUG_LONG(ctx, tag, fmt, str)		BUTLER_LOG_AT(LOG_LEVEL_DEBUG, tag, LOG_PRINTFLN_LONG)(ctx, fmt, str)
+
+// Selects the log macro or the no-op by the token pasting, so the disabled call is never compiled
+#define BUTLER_LOG_AT(level, tag, log)			BUTLER_LOG_SELECT(BUTLER_LOG_GE(LOG_LEVEL_##tag, level), log)
+#define BUTLER_LOG_SELECT(on, log)				BUTLER_LOG_SELECT_(on, log)
+#define BUTLER_LOG_SELECT_(on, log)				BUTLER_LOG_SELECT_##on(log)
+#define BUTLER_LOG_SELECT_0(log)				BUTLER_LOG_NOP
+#define BUTLER_LOG_SELECT_1(log)				log
+#define BUTLER_LOG_NOP(...)						((void)0)
+#define BUTLER_LOG_GE(threshold, level)			BUTLER_LOG_GE_(threshold, level)
+#define BUTLER_LOG_GE_(threshold, level)		BUTLER_LOG_GE_##threshold##_##level
+#define BUTLER_LOG_GE_0_1						0
+#define BUTLER_LOG_GE_0_2						0
+#define BUTLER_LOG_GE_0_3						0
+#define BUTLER_LOG_GE_0_4						0
+#define BUTLER_LOG_GE_1_1						1
+#define BUTLER_LOG_GE_1_2						0
+#define BUTLER_LOG_GE_1_3						0
+#define BUTLER_LOG_GE_1_4						0
+#define BUTLER_LOG_GE_2_1						1
+#define BUTLER_LOG_GE_2_2						1
+#define BUTLER_LOG_GE_2_3						0
+#define BUTLER_LOG_GE_2_4						0
+#define BUTLER_LOG_GE_3_1						1
+#define BUTLER_LOG_GE_3_2						1
+#define BUTLER_LOG_GE_3_3						1
+#define BUTLER_LOG_GE_3_4						0
+#define BUTLER_LOG_GE_4_1						1
+#define BUTLER_LOG_GE_4_2						1
+#define BUTLER_LOG_GE_4_3						1
+#define BUTLER_LOG_GE_4_4						1
 
 
 namespace Butler {
@@ -58,49 +173,198 @@ namespace Arduino {
 
 namespace LoggerPrivate {
 
-inline void vsnprintf_I(char* str, int strSize, const char *fmt, va_list ap) {
-#if BUTLER_PSTR_ENABLED
-				::vsnprintf_P(str, strSize, fmt, ap);
-#else
-				::vsnprintf(str, strSize, fmt, ap);
-#endif
+/**
+ * Binary record:
+ *   SYNC | size | ID (4 bytes) | time in ms (4 bytes) | arguments
+ * The size counts the bytes after itself. Every argument is the tag
+ * `(kind << 4) | size` and the little-endian value, the string is the tag,
+ * the length byte and the characters.
+ * The ID zero is the dropped records counter (one `uint16_t` argument).
+ */
+namespace Binary {
+
+const uint8_t SYNC										= 0xA5;
+
+const uint8_t KIND_INT									= 1;
+const uint8_t KIND_UINT									= 2;
+const uint8_t KIND_FLOAT								= 3;
+const uint8_t KIND_STR									= 4;
+const uint8_t KIND_PTR									= 5;
+
+/** SYNC, size, ID and time */
+const uint8_t HEADER_SIZE								= 10;
+
+class Record {
+	// The long string is split to the records, every record must take a character
+	static_assert(LOG_BINARY_RECORD_SIZE_MAX >= HEADER_SIZE + 3, "Record is too small for a string character");
+	static_assert(LOG_BINARY_RECORD_SIZE_MAX <= 255, "Record is too big for the size byte");
+public:
+	Record(uint32_t id, uint32_t time): mSize(0), mTruncated(false) {
+		mBuf[mSize++] = SYNC;
+		mSize++; // size
+		putValue(id);
+		putValue(time);
+	}
+
+	void arg(bool v) { putArg(KIND_UINT, static_cast<uint8_t>(v)); }
+	void arg(char v) { putArg(KIND_INT, static_cast<int8_t>(v)); }
+	void arg(signed char v) { putArg(KIND_INT, v); }
+	void arg(unsigned char v) { putArg(KIND_UINT, v); }
+	void arg(short v) { putArg(KIND_INT, v); }
+	void arg(unsigned short v) { putArg(KIND_UINT, v); }
+	void arg(int v) { putArg(KIND_INT, v); }
+	void arg(unsigned int v) { putArg(KIND_UINT, v); }
+	void arg(long v) { putArg(KIND_INT, v); }
+	void arg(unsigned long v) { putArg(KIND_UINT, v); }
+	void arg(long long v) { putArg(KIND_INT, v); }
+	void arg(unsigned long long v) { putArg(KIND_UINT, v); }
+	void arg(float v) { putFloat(&v, sizeof(v)); }
+	void arg(double v) { putFloat(&v, sizeof(v)); }
+	void arg(const void *v) { putArg(KIND_PTR, reinterpret_cast<uintptr_t>(v)); }
+	void arg(const char *v) { putStr(v ? v : "(null)"); }
+
+	void args() {}
+
+	template<typename ARG_T, typename... ARGS_T>
+	void args(ARG_T v, ARGS_T... rest) {
+		arg(v);
+		args(rest...);
+	}
+
+	/** Stores as many characters as fit, returns the stored quantity */
+	uint8_t putStr(const char *v) {
+		uint8_t len = 0;
+		if (fits(1)) {
+			const uint8_t lenIdx = mSize + 1;
+			mBuf[mSize] = KIND_STR << 4;
+			mSize += 2;
+			while (v[len] && room()) {
+				mBuf[mSize++] = v[len++];
+			}
+			mBuf[lenIdx] = len;
+		}
+		return len;
+	}
+
+	/** Gets the complete record */
+	const uint8_t* get() {
+		mBuf[1] = mSize - 2;
+		return mBuf;
+	}
+
+	uint8_t size() const { return mSize; }
+
+	uint8_t room() const { return sizeof(mBuf) - mSize; }
+
+private:
+	uint8_t												mBuf[LOG_BINARY_RECORD_SIZE_MAX];
+	uint8_t												mSize;
+	bool												mTruncated;
+
+	/** Checks the tag and the value fit, the rest arguments are dropped otherwise */
+	bool fits(uint8_t size) {
+		mTruncated = mTruncated || room() <= size;
+		return !mTruncated;
+	}
+
+	template<typename VALUE_T>
+	void putValue(VALUE_T v) {
+		for (uint8_t i = 0; i < sizeof(v); i++) {
+			mBuf[mSize++] = static_cast<uint8_t>(v >> (8 * i));
+		}
+	}
+
+	template<typename VALUE_T>
+	void putArg(uint8_t kind, VALUE_T v) {
+		if (fits(sizeof(v))) {
+			mBuf[mSize++] = (kind << 4) | sizeof(v);
+			putValue(v);
+		}
+	}
+
+	void putFloat(const void *v, uint8_t size) {
+		if (fits(size)) {
+			mBuf[mSize++] = (KIND_FLOAT << 4) | size;
+			memcpy(mBuf + mSize, v, size);
+			mSize += size;
+		}
+	}
+};
+
+struct Sink {
+	RingBuffer<LOG_BINARY_BUFFER_SIZE>					buffer;
+	uint16_t											droppedQty = 0;
+};
+
+inline Sink& sink() {
+	static Sink v;
+	return v;
 }
 
-inline void snprintf_I(char* str, int strSize, const char *fmt, ...) {
-	va_list ap;
-	va_start(ap, fmt);
-#if BUTLER_PSTR_ENABLED
-				::snprintf_P(str, strSize, fmt, ap);
-#else
-				::snprintf(str, strSize, fmt, ap);
-#endif
-	va_end(ap);
+inline uint32_t time(Context& ctx) {
+	return ctx.time ? ctx.time->millis() : 0;
 }
 
-inline size_t strlen_I(const char *str) {
-#if BUTLER_PSTR_ENABLED
-				return ::strlen_P(str);
-#else
-				return ::strlen(str);
-#endif
+inline void drain(Context& ctx) {
+	Sink &s = sink();
+	if (ctx.logger) {
+		uint8_t chunk[16];
+		uint32_t qty;
+		while ((qty = s.buffer.peek(BufferView(chunk, sizeof(chunk))))) {
+			ctx.logger->write(chunk, qty);
+			s.buffer.skip(qty);
+		}
+	}
 }
 
+/**
+ * Stores the record to the RAM buffer.
+ * The buffer is drained synchronously only if the record doesn't fit.
+ * The records are dropped and counted if there is no logger.
+ */
+inline void commit(Context& ctx, Record &record) {
+	Sink &s = sink();
+	if (s.droppedQty) {
+		Record dropped(0, time(ctx));
+		dropped.arg(s.droppedQty);
+		if (s.buffer.available() < dropped.size()) {
+			drain(ctx);
+		}
+		if (s.buffer.available() >= dropped.size()) {
+			s.buffer.push(ConstBufferView(dropped.get(), dropped.size()));
+			s.droppedQty = 0;
+		}
+	}
+	if (s.buffer.available() < record.size()) {
+		drain(ctx);
+	}
+	if (!s.droppedQty && s.buffer.available() >= record.size()) {
+		s.buffer.push(ConstBufferView(record.get(), record.size()));
+	} else if (s.droppedQty < 0xFFFF) {
+		s.droppedQty++;
+	}
+}
+
+} // Binary
+
 } // LoggerPrivate
 
 namespace Logger {
 
-const int LOG_SIZE_MAX									= 128;
-
+/**
+ * Formats the line straight to the logger, no line buffer and no length limit.
+ * The logger gets the short runs by `Print::write`.
+ */
 inline void logln_I(Context& ctx, const char *fmt, ...) {
 	if (ctx.logger) {
-		char buf[LOG_SIZE_MAX + 1];
 		{
+			Format::Writer writer(*ctx.logger);
 			va_list ap;
 			va_start(ap, fmt);
-			LoggerPrivate::vsnprintf_I(buf, LOG_SIZE_MAX, fmt, ap);
+			Format::vprint(writer, BUTLER_PSTR_ENABLED, fmt, ap);
 			va_end(ap);
-			buf[LOG_SIZE_MAX] = '\0';
-			ctx.logger->println(buf);
+			writer.put("\r\n", 2);
+			writer.flush();
 		}
 #if LOG_MEM_ENABLED
 	#ifdef __AVR__
@@ -110,36 +374,56 @@ inline void logln_I(Context& ctx, const char *fmt, ...) {
 			heapptr = stackptr;													// save value of heap pointer
 			free(stackptr);														// free up the memory again
 			stackptr =  (uint8_t *)(SP);										// save value of stack pointer
-			LoggerPrivate::snprintf_I(buf, LOG_SIZE_MAX, BUTLER_PSTR("SP:%u HP:%u"), stackptr, heapptr);
-			buf[LOG_SIZE_MAX] = '\0';
-			ctx.logger->println(buf);
+			Format::print(*ctx.logger, BUTLER_PSTR_ENABLED, BUTLER_PSTR("SP:%u HP:%u\r\n"), stackptr, heapptr);
 		}
 	#endif // __AVR__
 #endif
 	}
 }
 
+/** Kept for the long strings, the line is not limited anymore */
 inline void logln_I_long(Context& ctx, const char* fmt, const char* str) {
-	const uint8_t fmtSize = LoggerPrivate::strlen_I(fmt);
-	if (fmtSize >= LOG_SIZE_MAX) {
-		logln_I(ctx, BUTLER_PSTR("Too long format"));
-	} else {
-		const uint8_t chunkMaxSize = LOG_SIZE_MAX - fmtSize;
-		char chunkBuffer[chunkMaxSize + 1];
-		const char* cur = str;
-		uint32_t curSize;
-		do {
-			curSize = strlcpy(
-				chunkBuffer,
-				cur,
-				sizeof(chunkBuffer)
-			);
-			logln_I(ctx, fmt, chunkBuffer);
-			cur += chunkMaxSize;
-		} while(curSize > chunkMaxSize);
+	logln_I(ctx, fmt, str);
+}
+
+/**
+ * Writes the stored binary records to the logger and waits until
+ * the logger sends everything. Call it before the sleep.
+ */
+inline void flush(Context& ctx) {
+#if LOG_BINARY_ENABLED
+	LoggerPrivate::Binary::drain(ctx);
+#endif
+	if (ctx.logger) {
+		ctx.logger->flush();
 	}
 }
 
+/**
+ * Stores the record `{ID, time, arguments}` without formatting.
+ * The text is restored on the host by the ID, see `BUTLER_LOG_ID`.
+ */
+template<typename... ARGS_T>
+void logln_B(Context& ctx, const char *fmt, ARGS_T... args) {
+	LoggerPrivate::Binary::Record record(reinterpret_cast<uintptr_t>(fmt), LoggerPrivate::Binary::time(ctx));
+	record.args(args...);
+	LoggerPrivate::Binary::commit(ctx, record);
+}
+
+/** Splits the string to the records with the same ID */
+inline void logln_B_long(Context& ctx, const char* fmt, const char* str) {
+	const uint32_t time = LoggerPrivate::Binary::time(ctx);
+	do {
+		LoggerPrivate::Binary::Record record(reinterpret_cast<uintptr_t>(fmt), time);
+		const uint8_t len = record.putStr(str);
+		LoggerPrivate::Binary::commit(ctx, record);
+		if (!len) {
+			break;
+		}
+		str += len;
+	} while (*str);
+}
+
 } // Logger
 
 }}
@@ -39,6 +39,30 @@ String md5(File &file) {
 	}
 }
 
+TeeStream::TeeStream(File &file): mFile(file) {
+	mMd5.begin();
+}
+
+size_t TeeStream::write(uint8_t b) {
+	return write(&b, 1);
+}
+
+size_t TeeStream::write(const uint8_t *buf, size_t size) {
+	size_t res = mFile.write(buf, size);
+	// Only the data stored to the file
+	for (size_t i = 0; i < res;) {
+		uint16_t len = (res - i) > 0xFFFF ? 0xFFFF : (res - i);
+		mMd5.add(const_cast<uint8_t*>(buf + i), len);
+		i += len;
+	}
+	return res;
+}
+
+String TeeStream::md5() {
+	mMd5.calculate();
+	return mMd5.toString();
+}
+
 } // Md5
 
 }}
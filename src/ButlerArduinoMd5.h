@@ -16,7 +16,9 @@
 
 /* System Includes */
 #include <WString.h>
+#include <Stream.h>
 #include <FS.h>
+#include <MD5Builder.h>
 /* Internal Includes */
 
 
@@ -32,6 +34,40 @@ namespace Md5 {
  */
 String md5(File &file);
 
+/**
+ * Writes to the file and calculates MD5 of the written data on the fly.
+ * Use it as the download destination to skip the second pass over the file.
+ * Write only, reading returns nothing.
+ */
+class TeeStream: public ::Stream {
+public:
+	using ::Stream::write;
+
+	TeeStream(File &file);
+
+	size_t write(uint8_t b);
+
+	size_t write(const uint8_t *buf, size_t size);
+
+	int available() { return 0; }
+
+	int read() { return -1; }
+
+	int peek() { return -1; }
+
+	void flush() { mFile.flush(); }
+
+	/** Finalizes the calculation, returns the written data MD5 */
+	String md5();
+
+private:
+	File												&mFile;
+	MD5Builder											mMd5;
+
+	TeeStream(const TeeStream&);
+	TeeStream& operator=(const TeeStream&);
+};
+
 } // Md5
 
 }}
@@ -0,0 +1,235 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Memory profiler implementation.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+/* System Includes */
+#include <Arduino.h>
+#include <string.h>
+#if defined(__AVR__)
+extern "C" {
+	struct __freelist {
+		size_t											sz;
+		struct __freelist								*nx;
+	};
+	extern struct __freelist							*__flp;
+	extern char											*__brkval;
+	extern size_t										__malloc_margin;
+	extern uint8_t										__heap_start;
+}
+#elif defined(ESP8266)
+extern "C" {
+	#include <cont.h>
+	#include <umm_malloc/umm_malloc.h>
+	extern cont_t										g_cont;
+}
+#endif
+/* Internal Includes */
+#include "ButlerArduinoMemProfiler.h"
+#include "ButlerArduinoLogger.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+namespace MemProfiler {
+
+namespace {
+
+//////////////////////////////////// PLATFORM ///////////////////////////////////
+
+#if defined(__AVR__)
+
+const uint8_t PAINT										= 0xC5;
+
+/** The stack grows down to the heap end */
+uint8_t* heapEnd() {
+	return __brkval ? reinterpret_cast<uint8_t*>(__brkval) : &__heap_start;
+}
+
+uint32_t stackSize() {
+	return RAMEND + 1 - reinterpret_cast<uintptr_t>(&__heap_start);
+}
+
+void paint() {
+	uint8_t *p = heapEnd();
+	uint8_t *sp = reinterpret_cast<uint8_t*>(SP);
+	while (p < sp) {
+		*p++ = PAINT;
+	}
+}
+
+uint32_t stackUsed() {
+	const uint8_t *p = heapEnd();
+	const uint8_t *sp = reinterpret_cast<const uint8_t*>(SP);
+	while (p < sp && *p == PAINT) {
+		p++;
+	}
+	return RAMEND + 1 - reinterpret_cast<uintptr_t>(p);
+}
+
+Heap readHeap() {
+	Heap h = {0, 0, 0};
+	// Between the heap end and the stack, `malloc` keeps the margin for the stack
+	const uint16_t gap = reinterpret_cast<uint8_t*>(SP) - heapEnd();
+	if (gap > __malloc_margin) {
+		h.free = h.maxBlock = gap - __malloc_margin;
+	}
+	for (const __freelist *fl = __flp; fl; fl = fl->nx) {
+		h.free += fl->sz;
+		if (fl->sz > h.maxBlock) {
+			h.maxBlock = fl->sz;
+		}
+	}
+	return h;
+}
+
+#elif defined(ESP8266)
+
+// The `cont` stack is painted by the core, `cont_get_free_stack` counts the guards
+const uint32_t UMM_BLOCK_SIZE							= 8;
+
+uint32_t stackSize() {
+	return sizeof(g_cont.stack);
+}
+
+void paint() {
+	unsigned marker;
+	unsigned *p = g_cont.stack;
+	unsigned *sp = &marker;
+	if (sp < g_cont.stack || sp >= g_cont.stack + sizeof(g_cont.stack) / sizeof(g_cont.stack[0])) {
+		// Not on the `cont` stack, e.g. the SDK callback
+		return;
+	}
+	while (p < sp) {
+		*p++ = CONT_STACKGUARD;
+	}
+}
+
+uint32_t stackUsed() {
+	return sizeof(g_cont.stack) - cont_get_free_stack(&g_cont);
+}
+
+Heap readHeap() {
+	Heap h = {0, 0, 0};
+	umm_info(NULL, 0);
+	h.free = ESP.getFreeHeap();
+	h.maxBlock = ummHeapInfo.maxFreeContiguousBlocks * UMM_BLOCK_SIZE;
+	return h;
+}
+
+#else
+
+uint32_t stackSize() { return 0; }
+void paint() {}
+uint32_t stackUsed() { return 0; }
+Heap readHeap() { Heap h = {0, 0, 0}; return h; }
+
+#endif
+
+//////////////////////////////////// STATE //////////////////////////////////////
+
+Report													gReport;
+Phase													gPhase = PHASE_SETUP;
+bool													gActive = false;
+
+void update(Phase phase) {
+	PhaseStats &stats = gReport.phases[phase];
+	const uint32_t used = stackUsed();
+	if (used > stats.stackPeak) {
+		stats.stackPeak = used;
+	}
+	if (used > gReport.stackPeak) {
+		gReport.stackPeak = used;
+	}
+	const Heap h = heap();
+	if (h.free < stats.heapFreeMin) {
+		stats.heapFreeMin = h.free;
+	}
+	if (h.maxBlock < stats.heapMaxBlockMin) {
+		stats.heapMaxBlockMin = h.maxBlock;
+	}
+	if (h.fragmentation > stats.fragmentationMax) {
+		stats.fragmentationMax = h.fragmentation;
+	}
+}
+
+void getPhaseName(uint8_t phase, char name[8]) {
+	switch (phase) {
+		case PHASE_SETUP:		strcpy_P(name, PSTR("setup")); break;
+		case PHASE_CHECK:		strcpy_P(name, PSTR("check")); break;
+		case PHASE_CONNECT:		strcpy_P(name, PSTR("connect")); break;
+		case PHASE_LOOP:		strcpy_P(name, PSTR("loop")); break;
+		case PHASE_IDLE:		strcpy_P(name, PSTR("idle")); break;
+		default:				strcpy_P(name, PSTR("?")); break;
+	}
+}
+
+} // namespace
+
+void begin() {
+	memset(&gReport, 0, sizeof(gReport));
+	gReport.stackSize = stackSize();
+	for (uint8_t i = 0; i < PHASE_QTY; i++) {
+		gReport.phases[i].heapFreeMin = UINT32_MAX;
+		gReport.phases[i].heapMaxBlockMin = UINT32_MAX;
+	}
+	gActive = false;
+	paint();
+}
+
+void enter(Phase phase) {
+	if (gActive) {
+		update(gPhase);
+	}
+	gPhase = phase;
+	gActive = true;
+	gReport.phases[phase].enterQty++;
+	update(phase);
+	// The peak of the new phase only
+	paint();
+}
+
+Heap heap() {
+	Heap h = readHeap();
+	if (h.free) {
+		h.fragmentation = 100 - static_cast<uint8_t>(h.maxBlock * 100UL / h.free);
+	}
+	return h;
+}
+
+const Report& report() {
+	if (gActive) {
+		update(gPhase);
+	}
+	return gReport;
+}
+
+void log(Context &ctx) {
+	// Unused if the logs are compiled out
+	(void)ctx;
+	const Report &r = report();
+	LOG_INFO(ctx, MEM, "[mem] stack peak: %lu/%lu B", r.stackPeak, r.stackSize);
+	for (uint8_t i = 0; i < PHASE_QTY; i++) {
+		const PhaseStats &s = r.phases[i];
+		if (s.enterQty) {
+			char name[8];
+			getPhaseName(i, name);
+			LOG_INFO(ctx, MEM, "[mem] %s: stack %lu B, heap min %lu B, block min %lu B, frag max %u%%, qty %u",
+				name, s.stackPeak, s.heapFreeMin, s.heapMaxBlockMin, s.fragmentationMax, s.enterQty
+			);
+		}
+	}
+}
+
+} // MemProfiler
+
+}}
@@ -0,0 +1,105 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Memory profiler implementation.
+ *    Stack high-water mark by painting, heap fragmentation
+ *    and the per-phase peaks.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_MEM_PROFILER_H_
+#define BUTLER_ARDUINO_MEM_PROFILER_H_
+
+/* System Includes */
+#include <stdint.h>
+/* Internal Includes */
+#include "ButlerArduinoContext.hpp"
+
+
+#ifndef BUTLER_ARDUINO_MEM_PROFILER_ENABLED
+	#define BUTLER_ARDUINO_MEM_PROFILER_ENABLED			0
+#endif
+
+#if BUTLER_ARDUINO_MEM_PROFILER_ENABLED
+	#define MEM_PROFILER_BEGIN()						Butler::Arduino::MemProfiler::begin()
+	#define MEM_PROFILER_PHASE(phase)					Butler::Arduino::MemProfiler::enter(Butler::Arduino::MemProfiler::PHASE_##phase)
+	#define MEM_PROFILER_LOG(ctx)						Butler::Arduino::MemProfiler::log(ctx)
+#else
+	#define MEM_PROFILER_BEGIN()						((void)0)
+	#define MEM_PROFILER_PHASE(phase)					((void)0)
+	#define MEM_PROFILER_LOG(ctx)						((void)0)
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * The stack below the current pointer is painted by the pattern, the
+ * first overwritten byte marks the deepest stack use since the painting.
+ * The stack is painted again on every phase change, so every phase
+ * has its own peak. The heap state is sampled on the phase change.
+ * Supported on AVR (main stack, avr-libc heap) and ESP8266 (`cont` stack,
+ * umm heap), the other platforms report zeros.
+ * Use the macros, they compile to nothing without `BUTLER_ARDUINO_MEM_PROFILER_ENABLED`.
+ */
+namespace MemProfiler {
+
+enum Phase {
+	PHASE_SETUP,
+	PHASE_CHECK,
+	PHASE_CONNECT,
+	PHASE_LOOP,
+	PHASE_IDLE,
+	PHASE_QTY
+};
+
+struct Heap {
+	uint32_t											free;
+	uint32_t											maxBlock;
+	/** 100 * (1 - maxBlock / free), zero if no free memory */
+	uint8_t												fragmentation;
+};
+
+struct PhaseStats {
+	/** Deepest stack use in bytes */
+	uint32_t											stackPeak;
+	/** Lowest free heap and the lowest largest free block */
+	uint32_t											heapFreeMin;
+	uint32_t											heapMaxBlockMin;
+	uint8_t												fragmentationMax;
+	uint16_t											enterQty;
+};
+
+struct Report {
+	uint32_t											stackSize;
+	/** Deepest stack use since `begin` */
+	uint32_t											stackPeak;
+	PhaseStats											phases[PHASE_QTY];
+};
+
+/** Paints the stack, must be called once on board start */
+void begin();
+
+/** Closes the current phase and starts the new one */
+void enter(Phase phase);
+
+/** Gets the current heap state */
+Heap heap();
+
+/** Gets the report, the current phase is included */
+const Report& report();
+
+/** Prints the report */
+void log(Context &ctx);
+
+} // MemProfiler
+
+}}
+
+#endif // BUTLER_ARDUINO_MEM_PROFILER_H_
@@ -0,0 +1,126 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: URL and topic model expansion implementation.
+ *    Replaces the model keys like `<id>` in a single pass without heap usage.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_MODEL_H_
+#define BUTLER_ARDUINO_MODEL_H_
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+namespace Model {
+
+/**
+ * The key (in flash) and its value.
+ * The value is in RAM unless `valueP` is set.
+ * `NULL` value leaves the key in place to expand it later.
+ */
+struct Key {
+	const char											*keyP;
+	const char											*value;
+	bool												valueP;
+};
+
+/** Checks if the model (in flash) starts with the key (in flash) */
+inline bool startsWithKey(const char *modelP, const char *keyP) {
+	char c;
+	while ((c = pgm_read_byte(keyP))) {
+		if (pgm_read_byte(modelP) != c) {
+			return false;
+		}
+		modelP++;
+		keyP++;
+	}
+	return true;
+}
+
+/** Enough to keep `uint32_t` in decimal form */
+const uint8_t UINT_DEC_SIZE								= 11;
+
+/**
+ * Writes the model (in flash) to the buffer replacing the keys by the values.
+ * The model is scanned once, the result is always terminated.
+ * Returns the full result length like `snprintf`, the result
+ * is truncated if the returned value is not less than the buffer size.
+ */
+inline uint32_t expand(const char *modelP, const Key keys[], uint8_t keysQty, const CharBufferView &out) {
+	uint32_t len = 0;
+	char *dst = out.get();
+	const uint32_t dstSize = out.size();
+	char c;
+	while ((c = pgm_read_byte(modelP))) {
+		const Key *key = NULL;
+		uint8_t keyLength = 0;
+		if (c == '<') {
+			for (uint8_t i = 0; i < keysQty; i++) {
+				if (keys[i].value) {
+					if (startsWithKey(modelP, keys[i].keyP)) {
+						keyLength = strlen_P(keys[i].keyP);
+						key = &keys[i];
+						break;
+					}
+				}
+			}
+		}
+		if (key) {
+			const char *value = key->value;
+			while ((c = key->valueP ? pgm_read_byte(value) : *value)) {
+				if (len + 1 < dstSize) {
+					dst[len] = c;
+				}
+				len++;
+				value++;
+			}
+			modelP += keyLength;
+		} else {
+			if (len + 1 < dstSize) {
+				dst[len] = c;
+			}
+			len++;
+			modelP++;
+		}
+	}
+	if (dstSize) {
+		dst[len < dstSize ? len : dstSize - 1] = '\0';
+	}
+	return len;
+}
+
+/** Writes the decimal form, returns `out` */
+inline const char* uintToDec(uint32_t v, char out[UINT_DEC_SIZE]) {
+	char tmp[UINT_DEC_SIZE];
+	uint8_t qty = 0;
+	do {
+		tmp[qty++] = '0' + (v % 10);
+		v /= 10;
+	} while (v);
+	for (uint8_t i = 0; i < qty; i++) {
+		out[i] = tmp[qty - 1 - i];
+	}
+	out[qty] = '\0';
+	return out;
+}
+
+} // Model
+
+}}
+
+#endif // BUTLER_ARDUINO_MODEL_H_
@@ -0,0 +1,112 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: MQTT packets over the Network implementation.
+ *    Sends the packets without joining the parts into one buffer.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_MQTT_H_
+#define BUTLER_ARDUINO_MQTT_H_
+
+/* System Includes */
+#include <stdint.h>
+#include <string.h>
+#include <MqttClient.h>
+/* Internal Includes */
+#include "ButlerArduinoNetwork.hpp"
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoBufferChain.hpp"
+
+
+#ifndef BUTLER_ARDUINO_MQTT_CHAIN_SIZE_MAX
+	#define BUTLER_ARDUINO_MQTT_CHAIN_SIZE_MAX			6
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+namespace Mqtt {
+
+const uint8_t PACKET_TYPE_PUBLISH						= 0x30;
+const uint8_t PACKET_FLAG_RETAIN						= 0x01;
+const uint32_t REMAINING_LENGTH_MAX						= 268435455UL;
+
+/** Gets the encoded remaining length field size */
+constexpr uint32_t remainingLengthSize(uint32_t length) {
+	return length < 128UL ? 1 : length < 16384UL ? 2 : length < 2097152UL ? 3 : 4;
+}
+
+/** Gets the QoS 0 PUBLISH packet size. Use to check the MQTT buffers at compile time. */
+constexpr uint32_t publishPacketSize(uint32_t topicLength, uint32_t payloadSize) {
+	return 1 + remainingLengthSize(2 + topicLength + payloadSize) + 2 + topicLength + payloadSize;
+}
+
+/**
+ * Sends the QoS 0 PUBLISH packet.
+ * The fixed header, the topic and the payload views go to the Network
+ * as one chain.
+ * Returns the written bytes quantity or negative value on error.
+ */
+inline int publish(Network &network, const char *topic, const BufferChainBase &payload,
+		bool retained, unsigned long timeoutMs)
+{
+	const uint16_t topicSize = strlen(topic);
+	uint32_t remainingLength = 2 + topicSize + payload.size();
+	if (remainingLength > REMAINING_LENGTH_MAX) {
+		return -1;
+	}
+	// Fixed header + topic length
+	uint8_t header[1 + 4 + 2];
+	uint8_t headerSize = 0;
+	header[headerSize++] = PACKET_TYPE_PUBLISH | (retained ? PACKET_FLAG_RETAIN : 0);
+	do {
+		uint8_t v = remainingLength % 128;
+		remainingLength /= 128;
+		header[headerSize++] = remainingLength ? (v | 0x80) : v;
+	} while (remainingLength);
+	header[headerSize++] = topicSize >> 8;
+	header[headerSize++] = topicSize & 0xFF;
+	// Chain
+	BufferChain<BUTLER_ARDUINO_MQTT_CHAIN_SIZE_MAX> packet;
+	packet.add(ConstBufferView(header, headerSize));
+	packet.add(ConstBufferView(reinterpret_cast<const uint8_t*>(topic), topicSize));
+	if (!packet.add(payload)) {
+		return -1;
+	}
+	// Send
+	int rc = network.write(packet, timeoutMs);
+	return (rc == static_cast<int>(packet.size())) ? rc : -1;
+}
+
+typedef void (*PayloadChainBuilder_f)(BufferChainBase& chain, const CharBufferView& scratch);
+
+/**
+ * Builds the payload chain in the `scratch` and sends it by `publish`
+ * on the network of the connected client.
+ * The failed write might leave the part of the packet on the wire =>
+ * the client is disconnected, so the next connect starts the clean stream.
+ */
+inline int publish(MqttClient &client, Network &network, const char *topic,
+		PayloadChainBuilder_f build, const CharBufferView &scratch, unsigned long timeoutMs)
+{
+	BufferChain<BUTLER_ARDUINO_MQTT_CHAIN_SIZE_MAX - 2> payload;
+	build(payload, scratch);
+	int rc = publish(network, topic, payload, false, timeoutMs);
+	if (rc < 0) {
+		client.disconnect();
+	}
+	return rc;
+}
+
+} // Mqtt
+
+}}
+
+#endif // BUTLER_ARDUINO_MQTT_H_
@@ -0,0 +1,60 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: MQTT stack implementation.
+ *    Holds the MQTT client together with all its parts.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_MQTT_STACK_H_
+#define BUTLER_ARDUINO_MQTT_STACK_H_
+
+/* System Includes */
+#include <stdint.h>
+#include <MqttClient.h>
+/* Internal Includes */
+
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * All buffer sizes are known at compile time, so the whole stack is one
+ * object. Place it to `StaticObject` to avoid the heap.
+ * MQTT_NETWORK_T is the ArduinoMqtt network adaptor like
+ * `MqttClient::NetworkImpl<Butler::Arduino::Network>`.
+ */
+template<class LOGGER_T, class MQTT_NETWORK_T, uint32_t SEND_BUFFER_SIZE, uint32_t RECV_BUFFER_SIZE,
+	uint8_t MESSAGE_HANDLERS_QTY = 1>
+class MqttStack {
+public:
+	template<class NETWORK_T>
+	MqttStack(const MqttClient::Options &options, MqttClient::System &system, LOGGER_T &logger, NETWORK_T &network)
+		: mLogger(logger), mNetwork(network, system),
+		mClient(options, mLogger, system, mNetwork, mSendBuffer, mRecvBuffer, mMessageHandlers)
+	{}
+
+	MqttClient& getClient() { return mClient; }
+
+private:
+	MqttClient::LoggerImpl<LOGGER_T>					mLogger;
+	MQTT_NETWORK_T										mNetwork;
+	MqttClient::ArrayBuffer<SEND_BUFFER_SIZE>			mSendBuffer;
+	MqttClient::ArrayBuffer<RECV_BUFFER_SIZE>			mRecvBuffer;
+	MqttClient::MessageHandlersImpl<MESSAGE_HANDLERS_QTY>	mMessageHandlers;
+	// Must be the last, uses all above
+	MqttClient											mClient;
+
+	MqttStack(const MqttStack&);
+	MqttStack& operator=(const MqttStack&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_MQTT_STACK_H_
@@ -16,6 +16,8 @@
 
 /* System Includes */
 /* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoBufferChain.hpp"
 
 
 namespace Butler {
@@ -28,6 +30,30 @@ public:
 	virtual int read(unsigned char* buffer, int len, unsigned long timeoutMs) = 0;
 	virtual int write(unsigned char* buffer, int len, unsigned long timeoutMs) = 0;
 	virtual int disconnect() = 0;
+
+	int read(const BufferView& buffer, unsigned long timeoutMs) {
+		return read(buffer.get(), buffer.size(), timeoutMs);
+	}
+
+	int write(const ConstBufferView& buffer, unsigned long timeoutMs) {
+		return write(const_cast<unsigned char*>(buffer.get()), buffer.size(), timeoutMs);
+	}
+
+	/**
+	 * Writes all views of the chain as one packet.
+	 * Returns the written bytes quantity or negative value on error.
+	 */
+	virtual int write(const BufferChainBase& chain, unsigned long timeoutMs) {
+		int res = 0;
+		for (uint8_t i = 0; i < chain.count(); ++i) {
+			int rc = write(chain[i], timeoutMs);
+			if (rc < 0) {
+				return rc;
+			}
+			res += rc;
+		}
+		return res;
+	}
 };
 
 }}
@@ -0,0 +1,93 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Payload size calculator.
+ *    Computes at compile time the JSON buffer size and the worst-case
+ *    serialized length of the payload.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_PAYLOAD_SIZE_H_
+#define BUTLER_ARDUINO_PAYLOAD_SIZE_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <ArduinoJson.h>
+/* Internal Includes */
+
+
+namespace Butler {
+namespace Arduino {
+
+namespace Payload {
+
+// Serialized value widths
+const uint32_t WIDTH_BOOL								= 5;	// false
+const uint32_t WIDTH_UINT8								= 3;
+const uint32_t WIDTH_INT8								= 4;
+const uint32_t WIDTH_UINT16								= 5;
+const uint32_t WIDTH_INT16								= 6;
+const uint32_t WIDTH_UINT32								= 10;
+const uint32_t WIDTH_INT32								= 11;
+
+/** Float with sign, point and trailing zeros removed */
+constexpr uint32_t floatWidth(uint32_t integralDigits, uint32_t decimalDigits) {
+	return 1 + integralDigits + (decimalDigits ? 1 + decimalDigits : 0);
+}
+
+/** Any float, ArduinoJson prints up to 7 integral and 6 decimal digits */
+const uint32_t WIDTH_FLOAT								= floatWidth(7, 6);
+
+/** String value with quotes */
+constexpr uint32_t stringWidth(uint32_t length) {
+	return 1 + length + 1;
+}
+
+/** Object member `"key":value` */
+constexpr uint32_t memberWidth(uint32_t keyLength, uint32_t valueWidth) {
+	return stringWidth(keyLength) + 1 + valueWidth;
+}
+
+/** Object or array with brackets and commas */
+constexpr uint32_t containerWidth(uint32_t itemsWidth, uint32_t itemsQty) {
+	return 1 + itemsWidth + (itemsQty ? itemsQty - 1 : 0) + 1;
+}
+
+/**
+ * Sensor payload `{"v":1,"id":"<id>","data":[{"<type>":<value>},...]}`.
+ * Sensor values are optional, the maximum is computed for all of them.
+ */
+template<uint32_t ID_LENGTH, uint8_t SENSORS_QTY, uint32_t TYPE_LENGTH_MAX = 5, uint32_t VALUE_WIDTH = WIDTH_FLOAT>
+struct SensorPayload {
+	/** Capacity of the JsonBuffer to build the payload */
+	static const size_t JSON_BUFFER_SIZE =
+		JSON_OBJECT_SIZE(3)											// root
+		+ JSON_ARRAY_SIZE(SENSORS_QTY)								// data array
+		+ JSON_OBJECT_SIZE(1) * SENSORS_QTY;						// data array elements
+
+	static const uint32_t SENSOR_WIDTH = containerWidth(memberWidth(TYPE_LENGTH_MAX, VALUE_WIDTH), 1);
+
+	/** Worst-case serialized length without the terminating null */
+	static const uint32_t LENGTH_MAX = containerWidth(
+		memberWidth(sizeof("v") - 1, WIDTH_UINT8)
+		+ memberWidth(sizeof("id") - 1, stringWidth(ID_LENGTH))
+		+ memberWidth(sizeof("data") - 1, containerWidth(SENSOR_WIDTH * SENSORS_QTY, SENSORS_QTY)),
+		3
+	);
+
+	/** Serialization buffer size including the terminating null */
+	static const uint32_t SIZE = LENGTH_MAX + 1;
+};
+
+} // Payload
+
+}}
+
+#endif // BUTLER_ARDUINO_PAYLOAD_SIZE_H_
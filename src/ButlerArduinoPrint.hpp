@@ -17,7 +17,9 @@
 
 /* System Includes */
 #include <stddef.h>
+#include <stdint.h>
 /* Internal Includes */
+#include "ButlerArduinoBufferChain.hpp"
 
 
 namespace Butler {
@@ -27,14 +29,29 @@ class Print {
 public:
 	virtual ~Print() {}
 	virtual size_t println(const char*) = 0;
+	/** Writes the raw bytes by one call */
+	virtual size_t write(const uint8_t buffer[], size_t size) = 0;
+	/** Writes all views of the chain, override if the sink can gather them */
+	virtual size_t write(const BufferChainBase &chain) {
+		size_t res = 0;
+		for (uint8_t i = 0; i < chain.count(); ++i) {
+			res += write(chain[i].get(), chain[i].size());
+		}
+		return res;
+	}
+	/** Waits until all written bytes are sent */
+	virtual void flush() {}
 };
 
 template<class Print_t>
 class PrintAdaptor: public Print {
 public:
+	using Print::write;
+
 	PrintAdaptor(Print_t &print): mPrint(print) {}
 
 	size_t println(const char* v) { return mPrint.println(v); }
+	size_t write(const uint8_t buffer[], size_t size) { return mPrint.write(buffer, size); }
 private:
 	Print_t												&mPrint;
 };
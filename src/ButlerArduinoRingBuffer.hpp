@@ -0,0 +1,191 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Ring buffer implementation.
+ *    Lock-free single producer and single consumer queue.
+ *    One side might be an interrupt service routine.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_RING_BUFFER_H_
+#define BUTLER_ARDUINO_RING_BUFFER_H_
+
+/* System Includes */
+#include <stdint.h>
+/* Internal Includes */
+#include "ButlerArduinoBufferView.hpp"
+
+
+#if defined(__AVR__) || defined(ESP8266)
+	// Single core => only the compiler reordering has to be prevented
+	#define BUTLER_ARDUINO_RING_BUFFER_BARRIER()		__asm__ __volatile__ ("" ::: "memory")
+#else
+	#define BUTLER_ARDUINO_RING_BUFFER_BARRIER()		__atomic_thread_fence(__ATOMIC_ACQ_REL)
+#endif
+
+namespace Butler {
+namespace Arduino {
+
+#ifdef __AVR__
+	// Single byte access is atomic on AVR
+	typedef uint8_t RingBufferIndex;
+#else
+	typedef uint32_t RingBufferIndex;
+#endif
+
+/**
+ * The indexes are free-running and masked on access, so all the elements
+ * are usable and the full buffer differs from the empty one.
+ * Producer only calls `push`, consumer calls `pop`, `peek`, `skip` and `clear`.
+ * No interrupts are disabled, the index of each side is written by this side only.
+ */
+template<typename TYPE_T, uint32_t BUFFER_SIZE>
+class RingBufferBase {
+	static_assert(BUFFER_SIZE && !(BUFFER_SIZE & (BUFFER_SIZE - 1)), "Size must be a power of two");
+	static_assert(BUFFER_SIZE <= RingBufferIndex(~RingBufferIndex(0)) / 2 + 1, "Size is too big for the index");
+public:
+	RingBufferBase(): mHead(0), mTail(0), mHighWaterMark(0) {}
+
+	/** Gets the elements quantity the buffer can hold */
+	uint32_t capacity() const { return BUFFER_SIZE; }
+
+	/** Gets the stored elements quantity */
+	uint32_t size() const { return RingBufferIndex(mHead - mTail); }
+
+	/** Gets the free elements quantity */
+	uint32_t available() const { return BUFFER_SIZE - size(); }
+
+	bool empty() const { return mHead == mTail; }
+
+	bool full() const { return size() == BUFFER_SIZE; }
+
+	/** Gets the maximum elements quantity stored at once */
+	uint32_t highWaterMark() const { return mHighWaterMark; }
+
+	/** Resets the high-water mark. Producer side. */
+	void resetHighWaterMark() { mHighWaterMark = size(); }
+
+	/** Drops all stored elements. Consumer side. */
+	void clear() { mTail = mHead; }
+
+	/** Appends the element. Returns `false` if the buffer is full. */
+	bool push(const TYPE_T &v) {
+		const RingBufferIndex head = mHead;
+		if (RingBufferIndex(head - mTail) >= BUFFER_SIZE) {
+			return false;
+		}
+		mBuf[head & MASK] = v;
+		commitPush(head + 1);
+		return true;
+	}
+
+	/** Appends as many elements as fit. Returns the appended elements quantity. */
+	uint32_t push(const BufferViewBase<const TYPE_T> &data) {
+		const RingBufferIndex head = mHead;
+		uint32_t qty = BUFFER_SIZE - RingBufferIndex(head - mTail);
+		if (qty > data.size()) {
+			qty = data.size();
+		}
+		const uint32_t idx = head & MASK;
+		const uint32_t first = (qty < BUFFER_SIZE - idx) ? qty : (BUFFER_SIZE - idx);
+		copy(mBuf + idx, data.get(), first);
+		copy(mBuf, data.get() + first, qty - first);
+		commitPush(head + qty);
+		return qty;
+	}
+
+	/** Removes the oldest element. Returns `false` if the buffer is empty. */
+	bool pop(TYPE_T &v) {
+		if (!peek(v)) {
+			return false;
+		}
+		skip(1);
+		return true;
+	}
+
+	/** Removes the oldest elements to the span. Returns the removed elements quantity. */
+	uint32_t pop(const BufferViewBase<TYPE_T> &data) {
+		const uint32_t qty = peek(data);
+		skip(qty);
+		return qty;
+	}
+
+	/** Gets the oldest element without removing. Returns `false` if the buffer is empty. */
+	bool peek(TYPE_T &v) const {
+		const RingBufferIndex tail = mTail;
+		if (mHead == tail) {
+			return false;
+		}
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		v = mBuf[tail & MASK];
+		return true;
+	}
+
+	/** Copies the oldest elements to the span. Returns the copied elements quantity. */
+	uint32_t peek(const BufferViewBase<TYPE_T> &data) const {
+		const RingBufferIndex tail = mTail;
+		uint32_t qty = RingBufferIndex(mHead - tail);
+		if (qty > data.size()) {
+			qty = data.size();
+		}
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		const uint32_t idx = tail & MASK;
+		const uint32_t first = (qty < BUFFER_SIZE - idx) ? qty : (BUFFER_SIZE - idx);
+		copy(data.get(), mBuf + idx, first);
+		copy(data.get() + first, mBuf, qty - first);
+		return qty;
+	}
+
+	/** Removes up to `qty` oldest elements. Returns the removed elements quantity. */
+	uint32_t skip(uint32_t qty) {
+		const RingBufferIndex tail = mTail;
+		const uint32_t stored = RingBufferIndex(mHead - tail);
+		if (qty > stored) {
+			qty = stored;
+		}
+		// Elements must be read before the space is released
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		mTail = tail + qty;
+		return qty;
+	}
+
+private:
+	static const RingBufferIndex						MASK = BUFFER_SIZE - 1;
+
+	TYPE_T												mBuf[BUFFER_SIZE];
+	volatile RingBufferIndex							mHead;
+	volatile RingBufferIndex							mTail;
+	volatile RingBufferIndex							mHighWaterMark;
+
+	void commitPush(RingBufferIndex head) {
+		// Elements must be written before the index is published
+		BUTLER_ARDUINO_RING_BUFFER_BARRIER();
+		mHead = head;
+		const RingBufferIndex qty = head - mTail;
+		if (qty > mHighWaterMark) {
+			mHighWaterMark = qty;
+		}
+	}
+
+	static void copy(TYPE_T *dst, const TYPE_T *src, uint32_t qty) {
+		while (qty--) {
+			*dst++ = *src++;
+		}
+	}
+
+	RingBufferBase(const RingBufferBase&);
+	RingBufferBase& operator=(const RingBufferBase&);
+};
+
+template<uint32_t BUFFER_SIZE = 64>
+class RingBuffer: public RingBufferBase<uint8_t, BUFFER_SIZE> {};
+
+}}
+
+#endif // BUTLER_ARDUINO_RING_BUFFER_H_
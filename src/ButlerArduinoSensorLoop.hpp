@@ -18,8 +18,14 @@
 #include <MqttClient.h>
 /* Internal Includes */
 #include "ButlerArduinoContext.hpp"
+#include "ButlerArduinoLogger.hpp"
 #include "ButlerArduinoTime.hpp"
 #include "ButlerArduinoUtil.hpp"
+#include "ButlerArduinoNetwork.hpp"
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoBufferChain.hpp"
+#include "ButlerArduinoMqtt.hpp"
+#include "ButlerArduinoMemProfiler.h"
 
 
 #define BUTLER_ARDUINO_LOOP_CALL(func, ...) if(func) func(##__VA_ARGS__)
@@ -30,6 +36,7 @@ namespace Arduino {
 struct LoopConstants {
 	// Types
 	typedef void (*MessagePayloadBuilder_f)(char* buffer, int size);
+	typedef void (*MessagePayloadChainBuilder_f)(BufferChainBase& chain, const CharBufferView& scratch);
 	typedef void (*ConfigMessageProcessor_f)(MqttClient::MessageData& md);
 	typedef void (*Reset_f)(void);
 	typedef int (*NetworkConnect_f)(void);
@@ -58,12 +65,19 @@ struct LoopConstants {
 	NetworkHibernate_f									networkHibernate = NULL;
 	NetworkWakeUp_f										networkWakeUp = NULL;
 	MessagePayloadBuilder_f								buildMessagePayload = NULL;
+	/**
+	 * Optional, used instead of `buildMessagePayload` for QoS 0 when
+	 * the Network is available. The chain goes to the Network as is.
+	 */
+	MessagePayloadChainBuilder_f						buildMessagePayloadChain = NULL;
 	ConfigMessageProcessor_f							processConfigMessage = NULL;
 };
 
 struct LoopContext {
 	// Resources
 	MqttClient											*mqtt = NULL;
+	/** Optional, used to publish the payload chain */
+	Network												*network = NULL;
 
 	// Configuration
 	unsigned long										publishPeriodMs = 0;
@@ -79,12 +93,15 @@ struct LoopContext {
 namespace LoopPrivate {
 
 void idle(Context& gCtx, const LoopConstants& lConst, unsigned long ms) {
+	MEM_PROFILER_PHASE(IDLE);
 	BUTLER_ARDUINO_LOOP_CALL(lConst.networkHibernate);
 	gCtx.lpm->idle(ms);
 	BUTLER_ARDUINO_LOOP_CALL(lConst.networkWakeUp);
+	MEM_PROFILER_PHASE(LOOP);
 }
 
 void connect(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
+	MEM_PROFILER_PHASE(CONNECT);
 	if (0 == lConst.networkConnect()) {
 		MqttClient::Error::type rc = MqttClient::Error::SUCCESS;
 		MqttClient::ConnectResult connectResult;
@@ -97,7 +114,7 @@ void connect(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
 			rc = lCtx.mqtt->connect(options, connectResult);
 		}
 		if (rc != MqttClient::Error::SUCCESS) {
-			LOG_PRINTFLN(gCtx, "ERROR, Connect, rc:%i", rc);
+			LOG_ERROR(gCtx, LOOP, "ERROR, Connect, rc:%i", rc);
 		} else {
 			// Success
 			return;
@@ -114,7 +131,7 @@ bool updateConfig(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 			lConst.configTopic, lConst.configQoS, lConst.processConfigMessage
 		);
 		if (rc != MqttClient::Error::SUCCESS) {
-			LOG_PRINTFLN(gCtx,"ERROR, Subscribe, rc:%i", rc);
+			LOG_ERROR(gCtx, LOOP, "ERROR, Subscribe, rc:%i", rc);
 		} else {
 			// Listen for configuration
 			lCtx.mqtt->yield(lConst.configListenPeriodMs);
@@ -131,6 +148,38 @@ bool updateConfig(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 	return res;
 }
 
+bool publish(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
+	const int bufferSize = lConst.publishPayloadMaxSize;
+	char buffer[bufferSize];
+	memset(buffer, 0, bufferSize);
+	if (lConst.buildMessagePayloadChain && lCtx.network && lConst.publishQoS == MqttClient::QOS0) {
+		// Publish, no copy to the MQTT send buffer
+		int rc = Mqtt::publish(*lCtx.mqtt, *lCtx.network, lConst.publishTopic,
+			lConst.buildMessagePayloadChain, CharBufferView(buffer, bufferSize), lConst.commandTimeoutMs);
+		if (rc < 0) {
+			LOG_ERROR(gCtx, LOOP, "ERROR, Publish chain, rc:%i", rc);
+			return false;
+		}
+		return true;
+	}
+	// Build message payload
+	lConst.buildMessagePayload(buffer, bufferSize);
+	// Build message
+	MqttClient::Message message;
+	message.qos = lConst.publishQoS;
+	message.retained = false;
+	message.dup = false;
+	message.payload = (void*) buffer;
+	message.payloadLen = strlen(buffer) + 1;
+	// Publish
+	MqttClient::Error::type rc = lCtx.mqtt->publish(lConst.publishTopic, message);
+	if (rc != MqttClient::Error::SUCCESS) {
+		LOG_ERROR(gCtx, LOOP, "ERROR, Publish, rc:%i", rc);
+		return false;
+	}
+	return true;
+}
+
 } // Private
 
 namespace Loop {
@@ -144,13 +193,14 @@ inline void loop(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 	if (!lCtx.mqtt->isConnected()) {
 		// Connecting
 		LoopPrivate::connect(gCtx, lCtx, lConst);
+		MEM_PROFILER_PHASE(LOOP);
 		if (!lCtx.mqtt->isConnected()) {
 			if (++lCtx.connectCounter > lConst.connectAttemptsMaxQty) {
-				LOG_PRINTFLN(gCtx, "ERROR, Max retries qty has been reached => reset");
+				LOG_ERROR(gCtx, LOOP, "ERROR, Max retries qty has been reached => reset");
 				lConst.reset();
 				// Execution must stop at this point
 			}
-			LOG_PRINTFLN(gCtx, "Reconnect in %lu ms", lConst.disconnectedIdlePeriodMs);
+			LOG_DEBUG(gCtx, LOOP, "Reconnect in %lu ms", lConst.disconnectedIdlePeriodMs);
 			LoopPrivate::idle(gCtx, lConst, lConst.disconnectedIdlePeriodMs);
 		} else {
 			lCtx.connectCounter = 0;
@@ -173,23 +223,7 @@ inline void loop(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 		|| Time::isTimePassed(gCtx.time->millis(), lCtx.publishTs, lCtx.publishPeriodMs)
 	) {
 		// Time to Publish
-		const int bufferSize = lConst.publishPayloadMaxSize;
-		char buffer[bufferSize];
-		memset(buffer, 0, bufferSize);
-		// Build message payload
-		lConst.buildMessagePayload(buffer, bufferSize);
-		// Build message
-		MqttClient::Message message;
-		message.qos = lConst.publishQoS;
-		message.retained = false;
-		message.dup = false;
-		message.payload = (void*) buffer;
-		message.payloadLen = strlen(buffer) + 1;
-		// Publish
-		MqttClient::Error::type rc = lCtx.mqtt->publish(lConst.publishTopic, message);
-		if (rc != MqttClient::Error::SUCCESS) {
-			LOG_PRINTFLN(gCtx, "ERROR, Publish, rc:%i", rc);
-		} else {
+		if (LoopPrivate::publish(gCtx, lCtx, lConst)) {
 			lCtx.publishTs = gCtx.time->millis();
 			lCtx.firstPublish = false;
 		}
@@ -200,7 +234,7 @@ inline void loop(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 			Time::calcTimeLeft(gCtx.time->millis(), lCtx.configUpdateTs, lConst.configUpdatePeriodMs)
 		);
 		// Sleep
-		LOG_PRINTFLN(gCtx, "Idle for %lu ms", min(nextEventDelay, lCtx.mqtt->getIdleInterval()));
+		LOG_DEBUG(gCtx, LOOP, "Idle for %lu ms", min(nextEventDelay, lCtx.mqtt->getIdleInterval()));
 		LoopPrivate::idle(gCtx, lConst, min(nextEventDelay, lCtx.mqtt->getIdleInterval()));
 		// Determine the next event after wake up
 		nextEventDelay = min(
@@ -20,7 +20,12 @@
 #include "ButlerArduinoContext.hpp"
 #include "ButlerArduinoTime.hpp"
 #include "ButlerArduinoUtil.hpp"
+#include "ButlerArduinoNetwork.hpp"
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoBufferChain.hpp"
+#include "ButlerArduinoMqtt.hpp"
 #include "ButlerArduinoLogger.hpp"
+#include "ButlerArduinoMemProfiler.h"
 
 
 namespace Butler {
@@ -38,6 +43,7 @@ struct LoopStatus {
 struct LoopConstants {
 	// Types
 	typedef void (*MessagePayloadBuilder_f)(char* buffer, int size);
+	typedef void (*MessagePayloadChainBuilder_f)(BufferChainBase& chain, const CharBufferView& scratch);
 	typedef void (*ConfigMessageProcessor_f)(MqttClient::MessageData& md);
 
 	// Constants
@@ -49,15 +55,23 @@ struct LoopConstants {
 	const char*											configTopic = NULL;
 	MqttClient::QoS										configQoS = MqttClient::QOS0;
 	unsigned long										configListenPeriodMs = 0;
+	unsigned long										commandTimeoutMs = 0;
 
 	// Functions
 	MessagePayloadBuilder_f								buildMessagePayload = NULL;
+	/**
+	 * Optional, used instead of `buildMessagePayload` for QoS 0 when
+	 * the Network is available. The chain goes to the Network as is.
+	 */
+	MessagePayloadChainBuilder_f							buildMessagePayloadChain = NULL;
 	ConfigMessageProcessor_f								processConfigMessage = NULL;
 };
 
 struct LoopContext {
 	// Resources
 	MqttClient											*mqtt = NULL;
+	/** Optional, used to publish the payload chain */
+	Network												*network = NULL;
 
 	// Configuration
 	unsigned long										publishPeriodMs = 0;
@@ -80,7 +94,7 @@ void connect(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
 		// Success
 	} else {
 		// Failure
-		LOG_PRINTFLN(gCtx, "ERROR, Connect, rc:%i", rc);
+		LOG_ERROR(gCtx, LOOP, "ERROR, Connect, rc:%i", rc);
 	}
 }
 
@@ -92,10 +106,43 @@ void updateConfig(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 		// Listen for configuration
 		lCtx.mqtt->yield(lConst.configListenPeriodMs);
 	} else {
-		LOG_PRINTFLN(gCtx,"ERROR, Subscribe, rc:%i", rc);
+		LOG_ERROR(gCtx, LOOP, "ERROR, Subscribe, rc:%i", rc);
 	}
 }
 
+bool publish(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
+	// Prepare data for Publish
+	const int bufferSize = lConst.publishPayloadMaxSize;
+	char buffer[bufferSize];
+	memset(buffer, 0, bufferSize);
+	if (lConst.buildMessagePayloadChain && lCtx.network && lConst.publishQoS == MqttClient::QOS0) {
+		// Publish, no copy to the MQTT send buffer
+		int rc = Mqtt::publish(*lCtx.mqtt, *lCtx.network, lConst.publishTopic,
+			lConst.buildMessagePayloadChain, CharBufferView(buffer, bufferSize), lConst.commandTimeoutMs);
+		if (rc < 0) {
+			LOG_ERROR(gCtx, LOOP, "ERROR, Publish chain, rc:%i", rc);
+			return false;
+		}
+		return true;
+	}
+	// Build message payload
+	lConst.buildMessagePayload(buffer, bufferSize);
+	// Build message
+	MqttClient::Message message;
+	message.qos = lConst.publishQoS;
+	message.retained = false;
+	message.dup = false;
+	message.payload = (void*) buffer;
+	message.payloadLen = strlen(buffer) + 1;
+	// Publish
+	MqttClient::Error::type rc = lCtx.mqtt->publish(lConst.publishTopic, message);
+	if (rc != MqttClient::Error::SUCCESS) {
+		LOG_ERROR(gCtx, LOOP, "ERROR, Publish, rc:%i", rc);
+		return false;
+	}
+	return true;
+}
+
 } // Private
 
 namespace Loop {
@@ -107,29 +154,16 @@ inline void setup(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst)
 inline LoopStatus::type loop(Context& gCtx, LoopContext& lCtx, const LoopConstants& lConst) {
 	LoopStatus::type res = LoopStatus::SUCCESS;
 	// Connecting
+	MEM_PROFILER_PHASE(CONNECT);
 	LoopPrivate::connect(gCtx, lCtx, lConst);
 	if (!lCtx.mqtt->isConnected()) {
 		return LoopStatus::CONNECTION_FAILURE;
 	}
+	MEM_PROFILER_PHASE(LOOP);
 	// Update configuration
 	LoopPrivate::updateConfig(gCtx, lCtx, lConst);
-	// Prepare data for Publish
-	const int bufferSize = lConst.publishPayloadMaxSize;
-	char buffer[bufferSize];
-	memset(buffer, 0, bufferSize);
-	// Build message payload
-	lConst.buildMessagePayload(buffer, bufferSize);
-	// Build message
-	MqttClient::Message message;
-	message.qos = lConst.publishQoS;
-	message.retained = false;
-	message.dup = false;
-	message.payload = (void*) buffer;
-	message.payloadLen = strlen(buffer) + 1;
 	// Publish
-	MqttClient::Error::type rc = lCtx.mqtt->publish(lConst.publishTopic, message);
-	if (rc != MqttClient::Error::SUCCESS) {
-		LOG_PRINTFLN(gCtx, "ERROR, Publish, rc:%i", rc);
+	if (!LoopPrivate::publish(gCtx, lCtx, lConst)) {
 		res = LoopStatus::FAILURE;
 	}
 	return lCtx.mqtt->isConnected() ? res : LoopStatus::CONNECTION_FAILURE;
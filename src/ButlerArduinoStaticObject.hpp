@@ -0,0 +1,75 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Static object implementation.
+ *    Statically allocated storage for the object constructed at run time.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_STATIC_OBJECT_H_
+#define BUTLER_ARDUINO_STATIC_OBJECT_H_
+
+/* System Includes */
+#include <stddef.h>
+#include <stdint.h>
+/* Internal Includes */
+
+
+namespace Butler {
+namespace Arduino {
+
+struct StaticObjectTag {};
+
+}}
+
+/** Placement form of own signature, not every Arduino core declares the standard one */
+inline void* operator new(size_t, Butler::Arduino::StaticObjectTag, void *ptr) { return ptr; }
+inline void operator delete(void*, Butler::Arduino::StaticObjectTag, void*) {}
+
+namespace Butler {
+namespace Arduino {
+
+/**
+ * Replaces `new T(...)` in `setup()` with no heap usage.
+ * Declare it globally, the constructor does nothing, so the object
+ * is constructed when `create` is called.
+ * The object is never destroyed.
+ */
+template<class TYPE_T>
+class StaticObject {
+public:
+	StaticObject(): mCreated(false) {}
+
+	/** Constructs the object. Must be called once. */
+	template<typename... ARGS_T>
+	TYPE_T& create(ARGS_T&&... args) {
+		TYPE_T *obj = new (StaticObjectTag(), static_cast<void*>(mStorage)) TYPE_T(static_cast<ARGS_T&&>(args)...);
+		mCreated = true;
+		return *obj;
+	}
+
+	bool created() const { return mCreated; }
+
+	TYPE_T& get() { return *reinterpret_cast<TYPE_T*>(mStorage); }
+	const TYPE_T& get() const { return *reinterpret_cast<const TYPE_T*>(mStorage); }
+
+	TYPE_T* operator->() { return &get(); }
+	TYPE_T& operator*() { return get(); }
+
+private:
+	alignas(TYPE_T) uint8_t								mStorage[sizeof(TYPE_T)];
+	bool												mCreated;
+
+	StaticObject(const StaticObject&);
+	StaticObject& operator=(const StaticObject&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_STATIC_OBJECT_H_
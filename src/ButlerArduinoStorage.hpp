@@ -18,6 +18,7 @@
 #include <stdint.h>
 /* Internal Includes */
 #include "ButlerArduinoBuffer.hpp"
+#include "ButlerArduinoBufferView.hpp"
 
 
 namespace Butler {
@@ -31,6 +32,18 @@ public:
 	virtual bool read(Buffer&) = 0;
 	virtual void write(const Buffer&) = 0;
 	virtual void reset() = 0;
+
+	/** Reads the stored data to the view */
+	bool read(const BufferView &view) {
+		ViewBuffer buffer(view);
+		return read(buffer);
+	}
+
+	/** Stores the data from the view */
+	void write(const ConstBufferView &view) {
+		const ViewBuffer buffer(BufferView(const_cast<uint8_t*>(view.get()), view.size()));
+		write(buffer);
+	}
 };
 
 }}
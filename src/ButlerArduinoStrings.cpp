@@ -12,6 +12,7 @@
  */
 
 /* System Includes */
+#include <Arduino.h>
 /* Internal Includes */
 #include "ButlerArduinoStrings.hpp"
 
@@ -21,62 +22,74 @@ namespace Arduino {
 
 namespace Strings {
 
-const char EMPTY[] = "";
-const char SPACE[] = " ";
-const char APP[] = "app";
-const char WIFI[] = "wifi";
-const char AUTH[] = "auth";
-const char PERIOD[] = "period";
-const char SSID[] = "ssid";
-const char PASSPHRASE[] = "passphrase";
-const char PAIRED[] = "paired";
-const char FINGERPRINTS[] = "fingerprints";
-const char TOKEN[] = "token";
-const char USERNAME[] = "username";
-const char PASSWORD[] = "password";
-
-const char PAYLOAD_KEY_VERSION[] = "v";
-const char PAYLOAD_KEY_ID[] = "id";
-const char PAYLOAD_KEY_DATA[] = "data";
-const char PAYLOAD_KEY_RESULTS[] = "results";
-const char PAYLOAD_KEY_VALUE[] = "value";
-const char PAYLOAD_KEY_SENSOR_DATA_TYPE_TEMPERATURE[] = "temp";
-const char PAYLOAD_KEY_SENSOR_DATA_TYPE_HUMIDITY[] = "humid";
-
-const char CERT_FORM_DER[] = "der";
-
-const char CERT_TYPE_CRT[] = "crt";
-const char CERT_TYPE_KEY[] = "key";
-
-const char MODEL_KEY_ADDR[] = "<a>";
-const char MODEL_KEY_PORT[] = "<p>";
-const char MODEL_KEY_NAMESPACE[] = "<ns>";
-const char MODEL_KEY_GROUP[] = "<g>";
-const char MODEL_KEY_ID[] = "<id>";
-const char MODEL_KEY_FORM[] = "<form>";
-const char MODEL_KEY_TYPE[] = "<type>";
-
-const char HEADER_AUTHORIZATION[] = "Authorization";
-const char HEADER_CONTENT_TYPE[] = "Content-Type";
-const char HEADER_X_MD5[] = "x-MD5";
-
-const char MIME_TYPE_APP_JSON[] = "application/json";
-
-const char URL_MODEL_UPDATE_FW[] = "https://<a>:<p>/fw/update/";
-const char URL_MODEL_UPDATE_FW_NOT_S[] = "http://<a>:<p>/fw/update/<id>/";
-const char URL_MODEL_FINGERPRINTS[] = "https://<a>:<p>/cert/fingerprints/<a>/";
-const char URL_MODEL_FINGERPRINTS_NOT_S[] = "http://<a>:<p>/cert/fingerprints/<a>/";
-const char URL_MODEL_TOKEN[] = "https://<a>:<p>/auth/token/";
-const char URL_MODEL_CERT_CA[] = "https://<a>:<p>/cert/ca/<form>/";
-const char URL_MODEL_CERT[] = "https://<a>:<p>/cert/client/<type>/<form>/";
-
-const char TOPIC_MODEL_CONFIG[] = "<ns>/<g>/<id>/config";
-const char TOPIC_MODEL_DATA[] = "<ns>/<g>/<id>/data";
-
-const char FILE_NAME_TEMP_DOWNLOAD[] = "/download.tmp";
-const char FILE_NAME_CERT_CA_CRT[] = "/ca.crt";
-const char FILE_NAME_CERT_CRT[] = "/crt";
-const char FILE_NAME_CERT_KEY[] = "/key";
+const char EMPTY[] PROGMEM = "";
+const char SPACE[] PROGMEM = " ";
+const char APP[] PROGMEM = "app";
+const char WIFI[] PROGMEM = "wifi";
+const char AUTH[] PROGMEM = "auth";
+const char PERIOD[] PROGMEM = "period";
+const char SSID[] PROGMEM = "ssid";
+const char PASSPHRASE[] PROGMEM = "passphrase";
+const char PAIRED[] PROGMEM = "paired";
+const char FINGERPRINTS[] PROGMEM = "fingerprints";
+const char TOKEN[] PROGMEM = "token";
+const char USERNAME[] PROGMEM = "username";
+const char PASSWORD[] PROGMEM = "password";
+
+const char PAYLOAD_KEY_VERSION[] PROGMEM = "v";
+const char PAYLOAD_KEY_ID[] PROGMEM = "id";
+const char PAYLOAD_KEY_DATA[] PROGMEM = "data";
+const char PAYLOAD_KEY_RESULTS[] PROGMEM = "results";
+const char PAYLOAD_KEY_VALUE[] PROGMEM = "value";
+const char PAYLOAD_KEY_SENSOR_DATA_TYPE_TEMPERATURE[] PROGMEM = "temp";
+const char PAYLOAD_KEY_SENSOR_DATA_TYPE_HUMIDITY[] PROGMEM = "humid";
+
+const char CERT_FORM_DER[] PROGMEM = "der";
+
+const char CERT_TYPE_CRT[] PROGMEM = "crt";
+const char CERT_TYPE_KEY[] PROGMEM = "key";
+
+const char MODEL_KEY_ADDR[] PROGMEM = "<a>";
+const char MODEL_KEY_PORT[] PROGMEM = "<p>";
+const char MODEL_KEY_NAMESPACE[] PROGMEM = "<ns>";
+const char MODEL_KEY_GROUP[] PROGMEM = "<g>";
+const char MODEL_KEY_ID[] PROGMEM = "<id>";
+const char MODEL_KEY_FORM[] PROGMEM = "<form>";
+const char MODEL_KEY_TYPE[] PROGMEM = "<type>";
+
+const char HEADER_AUTHORIZATION[] PROGMEM = "Authorization";
+const char HEADER_CONTENT_TYPE[] PROGMEM = "Content-Type";
+const char HEADER_X_MD5[] PROGMEM = "x-MD5";
+const char HEADER_X_RESET_REASON[] PROGMEM = "x-Reset-Reason";
+
+const char MIME_TYPE_APP_JSON[] PROGMEM = "application/json";
+const char MIME_TYPE_APP_OCTET_STREAM[] PROGMEM = "application/octet-stream";
+
+const char URL_MODEL_UPDATE_FW[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_UPDATE_FW("<a>", "<p>");
+const char URL_MODEL_UPDATE_FW_NOT_S[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_UPDATE_FW_NOT_S("<a>", "<p>", "<id>");
+const char URL_MODEL_FINGERPRINTS[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_FINGERPRINTS("<a>", "<p>");
+const char URL_MODEL_FINGERPRINTS_NOT_S[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_FINGERPRINTS_NOT_S("<a>", "<p>");
+const char URL_MODEL_TOKEN[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_TOKEN("<a>", "<p>");
+const char URL_MODEL_CERT_CA[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_CERT_CA("<a>", "<p>", "<form>");
+const char URL_MODEL_CERT[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_CERT("<a>", "<p>", "<type>", "<form>");
+const char URL_MODEL_CRASH_LOG[] PROGMEM = BUTLER_ARDUINO_URL_MODEL_CRASH_LOG("<a>", "<p>");
+
+const char TOPIC_MODEL_CONFIG[] PROGMEM = BUTLER_ARDUINO_TOPIC_MODEL_CONFIG("<ns>", "<g>", "<id>");
+const char TOPIC_MODEL_DATA[] PROGMEM = BUTLER_ARDUINO_TOPIC_MODEL_DATA("<ns>", "<g>", "<id>");
+
+const char FILE_NAME_TEMP_DOWNLOAD[] PROGMEM = "/download.tmp";
+const char FILE_NAME_CERT_CA_CRT[] PROGMEM = "/ca.crt";
+const char FILE_NAME_CERT_CRT[] PROGMEM = "/crt";
+const char FILE_NAME_CERT_KEY[] PROGMEM = "/key";
+const char FILE_NAME_DIGEST_MANIFEST[] PROGMEM = "/digest.mf";
+
+// Copied to `RamString<>`
+static_assert(sizeof(HEADER_X_MD5) <= RAM_STRING_SIZE, "Header is too long");
+static_assert(sizeof(FILE_NAME_TEMP_DOWNLOAD) <= RAM_STRING_SIZE, "File name is too long");
+static_assert(sizeof(FILE_NAME_CERT_CA_CRT) <= RAM_STRING_SIZE, "File name is too long");
+static_assert(sizeof(FILE_NAME_CERT_CRT) <= RAM_STRING_SIZE, "File name is too long");
+static_assert(sizeof(FILE_NAME_CERT_KEY) <= RAM_STRING_SIZE, "File name is too long");
+static_assert(sizeof(FILE_NAME_DIGEST_MANIFEST) <= RAM_STRING_SIZE, "File name is too long");
 
 } // Strings
 
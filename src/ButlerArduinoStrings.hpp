@@ -15,14 +15,84 @@
 #define BUTLER_ARDUINO_STRINGS_H_
 
 /* System Includes */
+#include <Arduino.h>
+#include <stdint.h>
 /* Internal Includes */
 
 
+#define BUTLER_ARDUINO_STR_(v)							#v
+#define BUTLER_ARDUINO_STR(v)							BUTLER_ARDUINO_STR_(v)
+
+/**
+ * Models expanded by the preprocessor if the values are known at build time,
+ * the arguments are string literals or the model keys:
+ *
+ *     BUTLER_ARDUINO_TOPIC_MODEL_DATA("butler", "sensor", "<id>") => "butler/sensor/<id>/data"
+ *
+ * Use `BUTLER_ARDUINO_STR` to make the port literal.
+ */
+#define BUTLER_ARDUINO_URL_MODEL_UPDATE_FW(A, P)		"https://" A ":" P "/fw/update/"
+#define BUTLER_ARDUINO_URL_MODEL_UPDATE_FW_NOT_S(A, P, ID)	"http://" A ":" P "/fw/update/" ID "/"
+#define BUTLER_ARDUINO_URL_MODEL_FINGERPRINTS(A, P)		"https://" A ":" P "/cert/fingerprints/" A "/"
+#define BUTLER_ARDUINO_URL_MODEL_FINGERPRINTS_NOT_S(A, P)	"http://" A ":" P "/cert/fingerprints/" A "/"
+#define BUTLER_ARDUINO_URL_MODEL_TOKEN(A, P)			"https://" A ":" P "/auth/token/"
+#define BUTLER_ARDUINO_URL_MODEL_CERT_CA(A, P, FORM)	"https://" A ":" P "/cert/ca/" FORM "/"
+#define BUTLER_ARDUINO_URL_MODEL_CERT(A, P, TYPE, FORM)	"https://" A ":" P "/cert/client/" TYPE "/" FORM "/"
+#define BUTLER_ARDUINO_URL_MODEL_CRASH_LOG(A, P)		"https://" A ":" P "/log/crash/"
+#define BUTLER_ARDUINO_TOPIC_MODEL_CONFIG(NS, G, ID)	NS "/" G "/" ID "/config"
+#define BUTLER_ARDUINO_TOPIC_MODEL_DATA(NS, G, ID)		NS "/" G "/" ID "/data"
+
 namespace Butler {
 namespace Arduino {
 
+/**
+ * All strings are in flash (PROGMEM).
+ * Use the `_P` functions and the helpers below to access them:
+ *   - `flash` for the API accepting `F()` strings (`String`, ArduinoJson keys)
+ *   - `RamString` for the API accepting RAM strings only
+ */
 namespace Strings {
 
+typedef const __FlashStringHelper*						FlashString;
+
+inline FlashString flash(const char *strP) {
+	return reinterpret_cast<FlashString>(strP);
+}
+
+inline uint32_t length(const char *strP) {
+	return strlen_P(strP);
+}
+
+inline bool equals(const char *s, const char *strP) {
+	return !strcmp_P(s, strP);
+}
+
+const uint8_t RAM_STRING_SIZE							= 32;
+
+/** Temporary RAM copy, the string is truncated to fit (see `truncated`) */
+template<uint8_t SIZE = RAM_STRING_SIZE>
+class RamString {
+	static_assert(SIZE >= 2, "Size is too small");
+public:
+	RamString(const char *strP) {
+		strncpy_P(mBuf, strP, SIZE - 1);
+		mBuf[SIZE - 1] = '\0';
+		// The copy is padded with zeros => the last character is set only if the string is long
+		mTruncated = mBuf[SIZE - 2] && pgm_read_byte(strP + SIZE - 1);
+	}
+
+	const char* c_str() const { return mBuf; }
+
+	operator const char*() const { return mBuf; }
+
+	/** Checks the flash string is longer than the copy */
+	bool truncated() const { return mTruncated; }
+
+private:
+	char												mBuf[SIZE];
+	bool												mTruncated;
+};
+
 extern const char EMPTY[];
 extern const char SPACE[];
 extern const char APP[];
@@ -61,8 +131,10 @@ extern const char MODEL_KEY_TYPE[];
 extern const char HEADER_AUTHORIZATION[];
 extern const char HEADER_CONTENT_TYPE[];
 extern const char HEADER_X_MD5[];
+extern const char HEADER_X_RESET_REASON[];
 
 extern const char MIME_TYPE_APP_JSON[];
+extern const char MIME_TYPE_APP_OCTET_STREAM[];
 
 extern const char URL_MODEL_UPDATE_FW[];
 extern const char URL_MODEL_UPDATE_FW_NOT_S[];
@@ -71,6 +143,7 @@ extern const char URL_MODEL_FINGERPRINTS_NOT_S[];
 extern const char URL_MODEL_TOKEN[];
 extern const char URL_MODEL_CERT_CA[];
 extern const char URL_MODEL_CERT[];
+extern const char URL_MODEL_CRASH_LOG[];
 
 extern const char TOPIC_MODEL_CONFIG[];
 extern const char TOPIC_MODEL_DATA[];
@@ -79,6 +152,7 @@ extern const char FILE_NAME_TEMP_DOWNLOAD[];
 extern const char FILE_NAME_CERT_CA_CRT[];
 extern const char FILE_NAME_CERT_CRT[];
 extern const char FILE_NAME_CERT_KEY[];
+extern const char FILE_NAME_DIGEST_MANIFEST[];
 
 } // Strings
 
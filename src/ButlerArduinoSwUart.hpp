@@ -33,28 +33,29 @@ struct SwUartConfig {
 
 class SwUart: public Uart {
 public:
-	SwUart(const SwUartConfig& config) {
-		mSerial = new SoftwareSerial(config.receivePin, config.transmitPin);
-		mSerial->begin(config.speed);
+	using Uart::write;
+
+	SwUart(const SwUartConfig& config): mSerial(config.receivePin, config.transmitPin) {
+		mSerial.begin(config.speed);
 	}
 
-	~SwUart() { delete mSerial; }
+	void setTimeout(unsigned long timeout) { mSerial.setTimeout(timeout); }
 
-	void setTimeout(unsigned long timeout) { mSerial->setTimeout(timeout); }
+	size_t readBytes(char *buffer, size_t length) { return mSerial.readBytes(buffer, length); }
 
-	size_t readBytes(char *buffer, size_t length) { return mSerial->readBytes(buffer, length); }
+	size_t write(uint8_t c) { return mSerial.write(c); }
 
-	size_t write(uint8_t c) { return mSerial->write(c); }
+	size_t write(const uint8_t buffer[], size_t size) { return mSerial.write(buffer, size); }
 
-	size_t print(const char c[]) { return mSerial->print(c); }
+	size_t print(const char c[]) { return mSerial.print(c); }
 
-	size_t println(const char c[]) { return mSerial->println(c); }
+	size_t println(const char c[]) { return mSerial.println(c); }
 
-	void flush(void) { mSerial->flush(); }
+	void flush(void) { mSerial.flush(); }
 
-	int available(void) { return mSerial->available(); }
+	int available(void) { return mSerial.available(); }
 private:
-	SoftwareSerial										*mSerial;
+	SoftwareSerial										mSerial;
 };
 
 }}
@@ -26,13 +26,24 @@ namespace Arduino {
 
 class Uart: public Print {
 public:
+	using Print::write;
+
 	virtual ~Uart() {}
 	virtual void setTimeout(unsigned long timeout) = 0;
 	virtual size_t readBytes(char *buffer, size_t length) = 0;
 	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t buffer[], size_t size) {
+		size_t n = 0;
+		while (n < size && write(buffer[n])) {
+			n++;
+		}
+		return n;
+	}
 	virtual size_t print(const char c[]) = 0;
 	virtual size_t println(const char c[]) = 0;
 	virtual void flush() = 0;
+	/** Gets the bytes quantity that can be written without blocking, zero if unknown */
+	virtual int availableForWrite() { return 0; }
 	virtual int available(void) = 0;
 };
 
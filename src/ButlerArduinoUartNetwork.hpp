@@ -25,6 +25,9 @@ namespace Arduino {
 
 class UartNetwork: public Network {
 public:
+	using Network::read;
+	using Network::write;
+
 	UartNetwork(Uart& uart): mUart(uart) {}
 
 	~UartNetwork() {}
@@ -38,11 +41,16 @@ public:
 
 	int write(unsigned char* buffer, int len, unsigned long timeoutMs) {
 		mUart.setTimeout(timeoutMs);
-		for (int i = 0; i < len; ++i) {
-			mUart.write(buffer[i]);
-		}
+		int res = mUart.write(buffer, len);
+		mUart.flush();
+		return res;
+	}
+
+	int write(const BufferChainBase& chain, unsigned long timeoutMs) {
+		mUart.setTimeout(timeoutMs);
+		int res = mUart.write(chain);
 		mUart.flush();
-		return len;
+		return res;
 	}
 
 	int disconnect() { return 0; }
@@ -15,11 +15,18 @@
 #define BUTLER_ARDUINO_UTIL_H_
 
 /* System Includes */
+#include <stdint.h>
 #include <WString.h>
 /* Internal Includes */
 #include "ButlerArduinoStrings.hpp"
+#include "ButlerArduinoBufferView.hpp"
+#include "ButlerArduinoModel.hpp"
 
 
+#ifndef BUTLER_ARDUINO_UTIL_MODEL_SIZE_MAX
+	#define BUTLER_ARDUINO_UTIL_MODEL_SIZE_MAX			128
+#endif
+
 namespace Butler {
 namespace Arduino {
 
@@ -37,29 +44,112 @@ namespace Arduino {
 
 namespace Util {
 
-String macAddressToHex(String mac) {
-	int idx;
-	while((idx = mac.indexOf(':')) >= 0) {
-		mac.remove(idx, 1);
+const uint8_t MAC_ADDRESS_HEX_SIZE						= 13;
+
+/** Writes the MAC address as 12 HEX digits, returns `out` */
+inline const char* macAddressToHex(const uint8_t mac[6], char out[MAC_ADDRESS_HEX_SIZE]) {
+	static const char digits[] = "0123456789ABCDEF";
+	for (uint8_t i = 0; i < 6; i++) {
+		out[i * 2] = digits[mac[i] >> 4];
+		out[i * 2 + 1] = digits[mac[i] & 0x0F];
+	}
+	out[MAC_ADDRESS_HEX_SIZE - 1] = '\0';
+	return out;
+}
+
+inline String macAddressToHex(const String &mac) {
+	char out[MAC_ADDRESS_HEX_SIZE];
+	uint8_t len = 0;
+	for (uint8_t i = 0; i < mac.length() && len < MAC_ADDRESS_HEX_SIZE - 1; i++) {
+		if (mac[i] != ':') {
+			out[len++] = mac[i];
+		}
 	}
-	return mac;
+	out[len] = '\0';
+	return String(out);
 }
 
-void setModelKey(String &model, const String &key, const String &value) {
+inline void setModelKey(String &model, const String &key, const String &value) {
 	model.replace(key, value);
 }
 
-String makeUrl(String model, const String &addr, const uint32_t port) {
-	setModelKey(model, Strings::MODEL_KEY_ADDR, addr);
-	setModelKey(model, Strings::MODEL_KEY_PORT, String(port));
-	return model;
+/**
+ * Expands the model (in flash) to the caller buffer, see `Model::expand`.
+ * Returns `false` if the result doesn't fit (the output is truncated), never allocates.
+ */
+inline bool expandModel(const CharBufferView &out, const char *modelP, const Model::Key keys[], uint8_t keysQty) {
+	return Model::expand(modelP, keys, keysQty, out) < out.size();
+}
+
+/** The empty string if the result is bigger than `BUTLER_ARDUINO_UTIL_MODEL_SIZE_MAX` */
+inline String expandModel(const char *modelP, const Model::Key keys[], uint8_t keysQty) {
+	char buf[BUTLER_ARDUINO_UTIL_MODEL_SIZE_MAX];
+	if (!expandModel(CharBufferView(buf, sizeof(buf)), modelP, keys, keysQty)) {
+		return String();
+	}
+	return String(buf);
+}
+
+/**
+ * Expands the URL model (in flash) to the buffer, see `Model::expand`.
+ * The `form` and `type` are in flash like `Strings::CERT_FORM_DER`.
+ * `NULL` optional values leave the keys in place.
+ */
+inline uint32_t makeUrl(const CharBufferView &out, const char *modelP, const char *addr, uint32_t port,
+		const char *formP = NULL, const char *typeP = NULL, const char *id = NULL)
+{
+	char portDec[Model::UINT_DEC_SIZE];
+	const Model::Key keys[] = {
+		{Strings::MODEL_KEY_ADDR, addr, false},
+		{Strings::MODEL_KEY_PORT, Model::uintToDec(port, portDec), false},
+		{Strings::MODEL_KEY_FORM, formP, true},
+		{Strings::MODEL_KEY_TYPE, typeP, true},
+		{Strings::MODEL_KEY_ID, id, false}
+	};
+	return Model::expand(modelP, keys, sizeof(keys) / sizeof(keys[0]), out);
+}
+
+inline String makeUrl(const char *modelP, const char *addr, uint32_t port,
+		const char *formP = NULL, const char *typeP = NULL, const char *id = NULL)
+{
+	char portDec[Model::UINT_DEC_SIZE];
+	const Model::Key keys[] = {
+		{Strings::MODEL_KEY_ADDR, addr, false},
+		{Strings::MODEL_KEY_PORT, Model::uintToDec(port, portDec), false},
+		{Strings::MODEL_KEY_FORM, formP, true},
+		{Strings::MODEL_KEY_TYPE, typeP, true},
+		{Strings::MODEL_KEY_ID, id, false}
+	};
+	return expandModel(modelP, keys, sizeof(keys) / sizeof(keys[0]));
+}
+
+inline String makeUrl(const char *modelP, const String &addr, const uint32_t port) {
+	return makeUrl(modelP, addr.c_str(), port);
+}
+
+/** Expands the topic model (in flash) to the buffer, see `Model::expand` */
+inline uint32_t makeTopic(const CharBufferView &out, const char *modelP,
+		const char *nameSpace, const char *group, const char *id)
+{
+	const Model::Key keys[] = {
+		{Strings::MODEL_KEY_NAMESPACE, nameSpace, false},
+		{Strings::MODEL_KEY_GROUP, group, false},
+		{Strings::MODEL_KEY_ID, id, false}
+	};
+	return Model::expand(modelP, keys, sizeof(keys) / sizeof(keys[0]), out);
+}
+
+inline String makeTopic(const char *modelP, const char *nameSpace, const char *group, const char *id) {
+	const Model::Key keys[] = {
+		{Strings::MODEL_KEY_NAMESPACE, nameSpace, false},
+		{Strings::MODEL_KEY_GROUP, group, false},
+		{Strings::MODEL_KEY_ID, id, false}
+	};
+	return expandModel(modelP, keys, sizeof(keys) / sizeof(keys[0]));
 }
 
-String makeTopic(String model, const String &nameSpace, const String &group, const String &id) {
-	setModelKey(model, Strings::MODEL_KEY_NAMESPACE, nameSpace);
-	setModelKey(model, Strings::MODEL_KEY_GROUP, group);
-	setModelKey(model, Strings::MODEL_KEY_ID, id);
-	return model;
+inline String makeTopic(const char *modelP, const String &nameSpace, const String &group, const String &id) {
+	return makeTopic(modelP, nameSpace.c_str(), group.c_str(), id.c_str());
 }
 
 } // Util
@@ -32,7 +32,7 @@ struct WiFiJsonConfig: public JsonConfigNode, public WiFiConfig {
 		bool updated = false;
 		// SSID
 		{
-			const char *v = json[Strings::SSID];
+			const char *v = json[Strings::flash(Strings::SSID)];
 			if (v && !ssid.equals(v)) {
 				ssid = v;
 				updated = true;
@@ -40,7 +40,7 @@ struct WiFiJsonConfig: public JsonConfigNode, public WiFiConfig {
 		}
 		// PASSPHRASE
 		{
-			const char *v = json[Strings::PASSPHRASE];
+			const char *v = json[Strings::flash(Strings::PASSPHRASE)];
 			if (v && !passphrase.equals(v)) {
 				passphrase = v;
 				updated = true;
@@ -51,10 +51,10 @@ struct WiFiJsonConfig: public JsonConfigNode, public WiFiConfig {
 
 	void encode(JsonObject &json, JsonBuffer &jsonBuffer) {
 		// SSID
-		json[Strings::SSID] = ssid.c_str();
+		json[Strings::flash(Strings::SSID)] = ssid.c_str();
 		// PASSPHRASE
 		if (passphrase.length()) {
-			json[Strings::PASSPHRASE] = passphrase.c_str();
+			json[Strings::flash(Strings::PASSPHRASE)] = passphrase.c_str();
 		}
 	}
 
@@ -0,0 +1,446 @@
+/*
+ *******************************************************************************
+ *
+ * Purpose: Network implementation over the XBee ZigBee API frames.
+ *
+ *******************************************************************************
+ * Copyright Oleg Kovalenko 2017.
+ *
+ * Distributed under the MIT License.
+ * (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+ *******************************************************************************
+ */
+
+#ifndef BUTLER_ARDUINO_XBEE_NETWORK_H_
+#define BUTLER_ARDUINO_XBEE_NETWORK_H_
+
+/* System Includes */
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+/* Internal Includes */
+#include "ButlerArduinoNetwork.hpp"
+#include "ButlerArduinoUart.hpp"
+#include "ButlerArduinoTime.hpp"
+
+
+namespace Butler {
+namespace Arduino {
+
+struct XbeeNetworkConfig {
+	/** Destination address like `DH` and `DL`, zero is the coordinator */
+	uint32_t											destinationHigh = 0;
+	uint32_t											destinationLow = 0;
+	/** The module is set to `AP=2`, the special bytes are escaped */
+	bool												escaped = false;
+	/** Maximum RF payload of one frame, see `NP` of the module */
+	uint8_t												payloadMaxSize = 84;
+	/** Time to get the join status in `connect` */
+	unsigned long										connectTimeoutMs = 1000;
+};
+
+struct XbeeNetworkStats {
+	uint16_t											checksumErrors;
+	/** Frames bigger than the buffer or from the other source */
+	uint16_t											droppedFrames;
+	/** No transmit status or not a success */
+	uint16_t											deliveryFailures;
+	/** Delivery status of the last failure, `0xFF` if no transmit status */
+	uint8_t												lastDeliveryStatus;
+};
+
+/** Receive Packet frame data (type, addresses, options, RF data) kept in the buffer */
+constexpr uint32_t xbeeRxFrameSize(uint32_t payloadMaxSize) {
+	return payloadMaxSize + 12;
+}
+
+/** Receive Packet frame on the UART: start, length, data and checksum, all but the start escaped */
+constexpr uint32_t xbeeRxFrameUartSize(uint32_t payloadMaxSize, bool escaped) {
+	return 1 + (escaped ? 2 : 1) * (2 + xbeeRxFrameSize(payloadMaxSize) + 1);
+}
+
+/**
+ * Speaks the API frames (`AP=1` or `AP=2`) instead of the transparent byte stream.
+ * Every written packet is sent by the Transmit Request frames (split by `payloadMaxSize`)
+ * to the configured destination, `write` returns when the Transmit Status confirms
+ * the delivery or fails. `read` gets the RF data of the Receive Packet frames and
+ * returns as soon as the requested bytes are here.
+ * `connect` checks the module is joined (`AI` command).
+ * The buffer keeps the not yet read RF data and the frame being parsed.
+ * The received frame that doesn't fit waits in the UART until `read` frees the space.
+ * It is not lost only if the UART RX ring holds the whole frame (`xbeeRxFrameUartSize`),
+ * and `write` can't see its Transmit Status behind it and times out: size the buffer
+ * for two frames (`2 * xbeeRxFrameSize(payloadMaxSize)`).
+ */
+template<uint32_t FRAME_BUFFER_SIZE = 128>
+class XbeeNetwork: public Network {
+	static_assert(FRAME_BUFFER_SIZE >= 32 && FRAME_BUFFER_SIZE <= 0xFFFF, "Wrong frame buffer size");
+public:
+	using Network::read;
+	using Network::write;
+
+	XbeeNetwork(Uart &uart, const XbeeNetworkConfig &config): mUart(uart), mConfig(config), mFrameId(0) {
+		memset(&mStats, 0, sizeof(mStats));
+		drop();
+	}
+
+	~XbeeNetwork() {}
+
+	int connect(const char* hostname, int port) {
+		// The gateway knows the broker address, the module only has to be joined
+		drop();
+		const uint8_t frameId = nextFrameId();
+		const uint8_t command[] = {FRAME_AT_COMMAND, frameId, 'A', 'I'};
+		beginFrame(sizeof(command));
+		putData(command, sizeof(command));
+		endFrame();
+		const unsigned long start = millis();
+		while (Time::calcTimeElapsed(millis(), start) < mConfig.connectTimeoutMs) {
+			if (poll() == FRAME_AT_RESPONSE) {
+				const uint8_t *frame = mFrame + mRxEnd;
+				// Type, id, command, status, value
+				if (mFrameLen >= 6 && frame[1] == frameId && frame[2] == 'A' && frame[3] == 'I') {
+					return (frame[4] == 0 && frame[5] == 0) ? 0 : -1;
+				}
+			}
+		}
+		return -1;
+	}
+
+	int read(unsigned char* buffer, int len, unsigned long timeoutMs) {
+		const unsigned long start = millis();
+		int res = 0;
+		for (;;) {
+			uint16_t qty = mRxEnd - mRxPos;
+			if (qty > len - res) {
+				qty = len - res;
+			}
+			memcpy(buffer + res, mFrame + mRxPos, qty);
+			mRxPos += qty;
+			res += qty;
+			if (mRxPos == mRxEnd && mState == STATE_START) {
+				mRxPos = mRxEnd = 0;
+			}
+			if (res >= len || Time::calcTimeElapsed(millis(), start) >= timeoutMs) {
+				break;
+			}
+			poll();
+		}
+		return res;
+	}
+
+	int write(unsigned char* buffer, int len, unsigned long timeoutMs) {
+		BufferChain<1> chain;
+		chain.add(ConstBufferView(buffer, len));
+		return write(chain, timeoutMs);
+	}
+
+	int write(const BufferChainBase& chain, unsigned long timeoutMs) {
+		const unsigned long start = millis();
+		const uint32_t total = chain.size();
+		uint32_t sent = 0;
+		uint8_t view = 0;
+		uint32_t offset = 0;
+		while (sent < total) {
+			const uint8_t qty = (total - sent) < mConfig.payloadMaxSize ? (total - sent) : mConfig.payloadMaxSize;
+			const uint8_t frameId = nextFrameId();
+			// Type, id, 64-bit and 16-bit (unknown) destination, radius, options
+			const uint8_t header[TX_REQUEST_HEADER_SIZE] = {
+				FRAME_TX_REQUEST, frameId,
+				uint8_t(mConfig.destinationHigh >> 24), uint8_t(mConfig.destinationHigh >> 16),
+				uint8_t(mConfig.destinationHigh >> 8), uint8_t(mConfig.destinationHigh),
+				uint8_t(mConfig.destinationLow >> 24), uint8_t(mConfig.destinationLow >> 16),
+				uint8_t(mConfig.destinationLow >> 8), uint8_t(mConfig.destinationLow),
+				0xFF, 0xFE, 0, 0
+			};
+			beginFrame(sizeof(header) + qty);
+			putData(header, sizeof(header));
+			for (uint8_t left = qty; left;) {
+				const ConstBufferView &v = chain[view];
+				const uint32_t n = (v.size() - offset) < left ? (v.size() - offset) : left;
+				putData(v.get() + offset, n);
+				left -= n;
+				offset += n;
+				if (offset == v.size()) {
+					view++;
+					offset = 0;
+				}
+			}
+			endFrame();
+			const uint8_t status = waitStatus(frameId, start, timeoutMs);
+			if (status) {
+				mStats.deliveryFailures++;
+				mStats.lastDeliveryStatus = status;
+				return -1;
+			}
+			sent += qty;
+		}
+		return sent;
+	}
+
+	int disconnect() {
+		drop();
+		return 0;
+	}
+
+	const XbeeNetworkStats& getStats() const {
+		return mStats;
+	}
+
+	void resetStats() {
+		memset(&mStats, 0, sizeof(mStats));
+	}
+
+private:
+	static const uint8_t								FRAME_START = 0x7E;
+	static const uint8_t								FRAME_ESCAPE = 0x7D;
+	static const uint8_t								FRAME_XON = 0x11;
+	static const uint8_t								FRAME_XOFF = 0x13;
+	static const uint8_t								FRAME_ESCAPE_MASK = 0x20;
+	static const uint8_t								FRAME_AT_COMMAND = 0x08;
+	static const uint8_t								FRAME_TX_REQUEST = 0x10;
+	static const uint8_t								FRAME_AT_RESPONSE = 0x88;
+	static const uint8_t								FRAME_TX_STATUS = 0x8B;
+	static const uint8_t								FRAME_RX_PACKET = 0x90;
+	static const uint8_t								TX_REQUEST_HEADER_SIZE = 14;
+	static const uint8_t								TX_STATUS_SIZE = 7;
+	static const uint8_t								RX_PACKET_HEADER_SIZE = 12;
+	static const uint8_t								DELIVERY_NO_STATUS = 0xFF;
+
+	enum State {
+		STATE_START,
+		STATE_LENGTH_HIGH,
+		STATE_LENGTH_LOW,
+		STATE_DATA,
+		STATE_CHECKSUM
+	};
+
+	Uart												&mUart;
+	const XbeeNetworkConfig								mConfig;
+	XbeeNetworkStats									mStats;
+	uint8_t												mFrameId;
+	uint8_t												mTxSum;
+	// Not read RF data is [mRxPos, mRxEnd), the parsed frame follows it
+	uint8_t												mFrame[FRAME_BUFFER_SIZE];
+	uint16_t											mRxPos;
+	uint16_t											mRxEnd;
+	// Parser
+	State												mState;
+	uint16_t											mFrameLen;
+	uint16_t											mFrameQty;
+	uint8_t												mSum;
+	bool												mEscape;
+	bool												mFrameDrop;
+
+	uint8_t nextFrameId() {
+		// Zero disables the status frame
+		if (!++mFrameId) {
+			mFrameId = 1;
+		}
+		return mFrameId;
+	}
+
+	void drop() {
+		mRxPos = mRxEnd = 0;
+		mState = STATE_START;
+		mEscape = false;
+	}
+
+	////////////////////////////////// TRANSMIT ////////////////////////////////
+
+	static bool isSpecial(uint8_t c) {
+		return c == FRAME_START || c == FRAME_ESCAPE || c == FRAME_XON || c == FRAME_XOFF;
+	}
+
+	/** Writes the runs of the plain bytes by one call */
+	void putRaw(const uint8_t *data, uint32_t size) {
+		if (!mConfig.escaped) {
+			mUart.write(data, size);
+			return;
+		}
+		uint32_t run = 0;
+		for (uint32_t i = 0; i < size; i++) {
+			if (isSpecial(data[i])) {
+				const uint8_t escaped[] = {FRAME_ESCAPE, uint8_t(data[i] ^ FRAME_ESCAPE_MASK)};
+				mUart.write(data + run, i - run);
+				mUart.write(escaped, sizeof(escaped));
+				run = i + 1;
+			}
+		}
+		mUart.write(data + run, size - run);
+	}
+
+	void putData(const uint8_t *data, uint32_t size) {
+		for (uint32_t i = 0; i < size; i++) {
+			mTxSum += data[i];
+		}
+		putRaw(data, size);
+	}
+
+	void beginFrame(uint16_t size) {
+		const uint8_t start = FRAME_START;
+		const uint8_t length[] = {uint8_t(size >> 8), uint8_t(size)};
+		mUart.write(&start, 1);
+		putRaw(length, sizeof(length));
+		mTxSum = 0;
+	}
+
+	void endFrame() {
+		const uint8_t checksum = 0xFF - mTxSum;
+		putRaw(&checksum, 1);
+		mUart.flush();
+	}
+
+	uint8_t waitStatus(uint8_t frameId, unsigned long start, unsigned long timeoutMs) {
+		while (Time::calcTimeElapsed(millis(), start) < timeoutMs) {
+			if (poll() == FRAME_TX_STATUS) {
+				const uint8_t *frame = mFrame + mRxEnd;
+				// Type, id, 16-bit address, retries, delivery, discovery
+				if (mFrameLen >= TX_STATUS_SIZE && frame[1] == frameId) {
+					return frame[5];
+				}
+			}
+		}
+		return DELIVERY_NO_STATUS;
+	}
+
+	////////////////////////////////// RECEIVE /////////////////////////////////
+
+	/**
+	 * Parses the available bytes until the end of one frame.
+	 * Returns the type of the parsed frame, zero if no frame yet.
+	 * The frame is at `mRxEnd` until the next call, the RF data is appended to the not read one.
+	 * The frame that doesn't fit next to the not read data is left in the UART
+	 * until `read` frees the space, so the received data is never dropped.
+	 */
+	uint8_t poll() {
+		while (hasSpace() && mUart.available() > 0) {
+			char c;
+			if (mUart.readBytes(&c, 1) != 1) {
+				break;
+			}
+			if (parse(c)) {
+				uint8_t *frame = mFrame + mRxEnd;
+				const uint8_t type = frame[0];
+				if (type == FRAME_RX_PACKET) {
+					onRxPacket(frame);
+				}
+				return type;
+			}
+		}
+		return 0;
+	}
+
+	/** Returns `true` if the valid frame is parsed */
+	bool parse(uint8_t c) {
+		if (mConfig.escaped) {
+			// The start is never escaped => resync on it
+			if (c == FRAME_START) {
+				beginParse();
+				return false;
+			}
+			if (mState == STATE_START) {
+				return false;
+			}
+			if (c == FRAME_ESCAPE) {
+				mEscape = true;
+				return false;
+			}
+			if (mEscape) {
+				c ^= FRAME_ESCAPE_MASK;
+				mEscape = false;
+			}
+		}
+		switch (mState) {
+			case STATE_START:
+				if (c == FRAME_START) {
+					beginParse();
+				}
+				break;
+			case STATE_LENGTH_HIGH:
+				mFrameLen = uint16_t(c) << 8;
+				mState = STATE_LENGTH_LOW;
+				break;
+			case STATE_LENGTH_LOW:
+				mFrameLen |= c;
+				mFrameQty = 0;
+				mSum = 0;
+				// Never fits => skip it
+				mFrameDrop = mFrameLen > FRAME_BUFFER_SIZE;
+				mState = mFrameLen ? STATE_DATA : STATE_START;
+				break;
+			case STATE_DATA:
+				if (!mFrameDrop) {
+					mFrame[mRxEnd + mFrameQty] = c;
+				}
+				mSum += c;
+				if (++mFrameQty == mFrameLen) {
+					mState = STATE_CHECKSUM;
+				}
+				break;
+			case STATE_CHECKSUM:
+				mState = STATE_START;
+				if (mFrameDrop) {
+					mStats.droppedFrames++;
+				} else if (uint8_t(mSum + c) != 0xFF) {
+					mStats.checksumErrors++;
+				} else {
+					return true;
+				}
+				break;
+		}
+		return false;
+	}
+
+	/** Moves the not read data to the beginning to free the space for the frame */
+	void compact() {
+		if (mRxPos) {
+			memmove(mFrame, mFrame + mRxPos, mRxEnd - mRxPos);
+			mRxEnd -= mRxPos;
+			mRxPos = 0;
+		}
+	}
+
+	/** Checks the frame data can be stored, the length is known before the first data byte */
+	bool hasSpace() {
+		if (mState != STATE_DATA || mFrameQty || mFrameDrop) {
+			return true;
+		}
+		compact();
+		return mFrameLen <= FRAME_BUFFER_SIZE - mRxEnd;
+	}
+
+	void beginParse() {
+		compact();
+		mState = STATE_LENGTH_HIGH;
+		mEscape = false;
+	}
+
+	void onRxPacket(uint8_t *frame) {
+		if (mFrameLen < RX_PACKET_HEADER_SIZE || !isFromDestination(frame + 1)) {
+			mStats.droppedFrames++;
+			return;
+		}
+		// Keep the RF data only
+		const uint16_t size = mFrameLen - RX_PACKET_HEADER_SIZE;
+		memmove(frame, frame + RX_PACKET_HEADER_SIZE, size);
+		mRxEnd += size;
+	}
+
+	bool isFromDestination(const uint8_t *source) const {
+		// The coordinator (zero) and the broadcast (0xFFFF) addresses never come as the source
+		if (!mConfig.destinationHigh) {
+			return true;
+		}
+		const uint32_t high = uint32_t(source[0]) << 24 | uint32_t(source[1]) << 16 | uint32_t(source[2]) << 8 | source[3];
+		const uint32_t low = uint32_t(source[4]) << 24 | uint32_t(source[5]) << 16 | uint32_t(source[6]) << 8 | source[7];
+		return high == mConfig.destinationHigh && low == mConfig.destinationLow;
+	}
+
+	XbeeNetwork(const XbeeNetwork&);
+	XbeeNetwork& operator=(const XbeeNetwork&);
+};
+
+}}
+
+#endif // BUTLER_ARDUINO_XBEE_NETWORK_H_